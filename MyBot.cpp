@@ -4,9 +4,13 @@
 #include "types.hpp"
 #include "batcher.hpp"
 #include "model.hpp"
+#include "device.hpp"
 
-#include <random>
+#include <algorithm>
+#include <chrono>
 #include <ctime>
+#include <random>
+#include <vector>
 
 #include <torch/torch.h>
 
@@ -14,89 +18,70 @@ using namespace std;
 using namespace hlt;
 
 
-torch::Tensor convertEntityStateToTensor(std::shared_ptr<EntityState> &entityStatePtr) {
-
-    auto entityState = entityStatePtr.get();
-    auto gameState = entityState->gameState.get();
-    auto playerId = entityState->playerId;
-    //Halite Location
-    //auto halite_location = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
-    auto steps_remaining = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
-    // //My global info
-    auto my_ships = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
-    auto my_ships_halite = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
-    auto my_dropoffs = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
-    auto my_score = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
-    //Enemy global info
-    auto enemy_ships = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
-    auto enemy_ships_halite = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
-    auto enemy_dropoffs = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
-    auto enemy_score = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
+const int FRAME_SIZE = GAME_HEIGHT * GAME_WIDTH;
 
-    //Ship specific information
-    auto entity_location = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
-    auto entity_energy = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
+//The game ends a bot that takes more than 2 seconds on a turn, so leave a safety margin for parsing and I/O
+const auto TURN_BUDGET = std::chrono::milliseconds(1500);
+//Ships per forward pass; between passes the bot checks that another one still fits in the budget
+const std::size_t INFERENCE_CHUNK = 64;
+//The cheap action of ships the network has no time left for
+const int64_t DEFAULT_ACTION = 4;
 
-    entity_location[entityState->entityY][entityState->entityX] = 1;
-    entity_energy[entityState->entityY][entityState->entityX] = entityState->halite_on_ship;
-
-    steps_remaining.fill_(gameState->steps_remaining);
+/*
+ * Encode the frames shared by every ship of a player, once per turn: [1, NUMBER_OF_SHARED_FRAMES, GAME_HEIGHT, GAME_WIDTH]
+ * The tensor uses the memory of frames, so frames must not change until the tensor is no longer used.
+ */
+torch::Tensor convertGameStateToSharedTensor(const GameState &gameState, long playerId, std::vector<float> &frames) {
+    frames.assign(NUMBER_OF_SHARED_FRAMES * FRAME_SIZE, 0.0f);
+    auto frame = [&frames](int index) { return frames.data() + index * FRAME_SIZE; };
 
+    //Halite location, steps remaining, then my and the enemy's ships, ship halite, dropoffs and score
     //TODO: Generalize for more players
-    if(playerId == 0) {
-        my_score.fill_(gameState->scores[0]);
-        enemy_score.fill_(gameState->scores[1]);
-    } else {
-        my_score.fill_(gameState->scores[1]);
-        enemy_score.fill_(gameState->scores[0]);
-    }
-
-    float haliteLocationArray[GAME_HEIGHT][GAME_WIDTH];
-
-    for(std::size_t y = 0; y < GAME_HEIGHT; y++) {
-        for(std::size_t x = 0; x < GAME_WIDTH; x++) {
-            auto cell = gameState->position[y][x];
-            haliteLocationArray[y][x] = cell.halite_on_ground;
+    const auto myScore = gameState.scores[playerId == 0 ? 0 : 1];
+    const auto enemyScore = gameState.scores[playerId == 0 ? 1 : 0];
+    for(int y = 0; y < GAME_HEIGHT; y++) {
+        for(int x = 0; x < GAME_WIDTH; x++) {
+            const auto &cell = gameState.position[y][x];
+            const auto index = y * GAME_WIDTH + x;
+            frame(0)[index] = cell.halite_on_ground;
+            frame(1)[index] = gameState.steps_remaining;
+            frame(5)[index] = myScore;
+            frame(9)[index] = enemyScore;
 
             if(cell.shipOwnerId == playerId) {
-                my_ships[y][x] = 1;
-                my_ships_halite[y][x] = cell.halite_on_ship;
+                frame(2)[index] = 1;
+                frame(3)[index] = cell.halite_on_ship;
             }
             else if (cell.shipOwnerId != -1) {
-                enemy_ships[y][x] = 1;
-                enemy_ships_halite[y][x] = cell.halite_on_ship;
+                frame(6)[index] = 1;
+                frame(7)[index] = cell.halite_on_ship;
             }
 
             if(cell.structureOwnerId == playerId) {
-                my_dropoffs[y][x] = 1;
+                frame(4)[index] = 1;
             }
             else if (cell.structureOwnerId != -1) {
-                enemy_dropoffs[y][x] = 1;
+                frame(8)[index] = 1;
             }
         }
     }
-
-    auto halite_location = torch::from_blob(haliteLocationArray, {GAME_HEIGHT, GAME_WIDTH});
-    std::vector<torch::Tensor> frames {halite_location, steps_remaining,
-    my_ships, my_ships_halite, my_dropoffs, my_score,
-    enemy_ships, enemy_ships_halite, enemy_dropoffs, enemy_score,
-    entity_location, entity_energy};
-
-    auto stateTensor = torch::stack(frames);
-    return stateTensor;
+    return torch::from_blob(frames.data(), {1, NUMBER_OF_SHARED_FRAMES, GAME_HEIGHT, GAME_WIDTH});
 }
 
-std::shared_ptr<EntityState> parseGameIntoEntityState(std::shared_ptr<GameState> &gameState, long playerId, int entityY, int entityX, float entityEnergy) {
-    auto entityStatePtr = std::make_shared<EntityState>();
-    auto entityState = entityStatePtr.get();
-
-    entityState->gameState = gameState;
-    entityState->entityY = entityY;
-    entityState->entityX = entityX;
-    entityState->halite_on_ship = (entityEnergy / MAX_HALITE_ON_SHIP) - 0.5;
-    entityState->playerId = playerId;
-
-    return entityStatePtr;
+/*
+ * Encode the location and halite of every ship: [N, NUMBER_OF_SHIP_FRAMES, GAME_HEIGHT, GAME_WIDTH]
+ * The tensor uses the memory of frames, so frames must not change until the tensor is no longer used.
+ */
+torch::Tensor convertShipsToTensor(const std::vector<std::shared_ptr<Ship>> &ships, std::vector<float> &frames) {
+    frames.assign(ships.size() * NUMBER_OF_SHIP_FRAMES * FRAME_SIZE, 0.0f);
+    for(std::size_t i = 0; i < ships.size(); i++) {
+        const auto &ship = ships[i];
+        auto shipFrames = frames.data() + i * NUMBER_OF_SHIP_FRAMES * FRAME_SIZE;
+        const auto index = ship->position.y * GAME_WIDTH + ship->position.x;
+        shipFrames[index] = 1;
+        shipFrames[FRAME_SIZE + index] = (ship->halite / MAX_HALITE_ON_SHIP) - 0.5;
+    }
+    return torch::from_blob(frames.data(), {static_cast<long>(ships.size()), NUMBER_OF_SHIP_FRAMES, GAME_HEIGHT, GAME_WIDTH});
 }
 
 std::shared_ptr<GameState> parseGameIntoGameState(hlt::Game &game) {
@@ -126,8 +111,8 @@ std::shared_ptr<GameState> parseGameIntoGameState(hlt::Game &game) {
     }
 
    int cellY = 0;
-   for(auto row : game.game_map.get()->cells) {
-        for (auto cell: row) {
+   for(const auto &row : game.game_map.get()->cells) {
+        for (const auto &cell: row) {
             auto x  = cell.position.x;
             auto y = cell.position.y;
 
@@ -144,7 +129,7 @@ std::shared_ptr<GameState> parseGameIntoGameState(hlt::Game &game) {
         }
     }
 
-    for(auto playerPtr : game.players) {
+    for(const auto &playerPtr : game.players) {
 
         auto player = playerPtr.get();
         //auto player = playerPair.second;
@@ -155,7 +140,7 @@ std::shared_ptr<GameState> parseGameIntoGameState(hlt::Game &game) {
         gameState->position[spawn->position.y][spawn->position.x].spawnPresent = true;
         gameState->position[spawn->position.y][spawn->position.x].structureOwnerId = player->id;
 
-        for(auto dropoffPair : player->dropoffs) {
+        for(const auto &dropoffPair : player->dropoffs) {
             auto dropoff = dropoffPair.second.get();
             gameState->position[dropoff->position.y][dropoff->position.x].dropOffPresent = true;
             gameState->position[dropoff->position.y][dropoff->position.x].structureOwnerId = player->id;
@@ -178,24 +163,29 @@ std::shared_ptr<GameState> parseGameIntoGameState(hlt::Game &game) {
 int main(int argc, char* argv[]) {
 
     unsigned int rng_seed;
-    if (argc > 1) {
+    if (argc > 1 && std::string(argv[1]).compare(0, 2, "--") != 0) {
         rng_seed = static_cast<unsigned int>(stoul(argv[1]));
     } else {
         rng_seed = static_cast<unsigned int>(time(nullptr));
     }
     mt19937 rng(rng_seed);
 
+    DeviceOptions deviceOptions;
+    const bool validOptions = parseDeviceOptions(argc, argv, deviceOptions);
+    configureThreads(deviceOptions);
+    const auto device = selectDevice(deviceOptions);
+
     Game game;
 
+    //The weights load on the CPU, then move to the device once
     ActorCriticNetwork myModel(/*training=*/false);
-    myModel.to(torch::kCPU);
     torch::load(myModel.conv1, "0conv1.pt");
     torch::load(myModel.conv2, "0conv2.pt");
     torch::load(myModel.conv3, "0conv3.pt");
     torch::load(myModel.fc1, "0fc1.pt");
     torch::load(myModel.fc2, "0fc2.pt");
     torch::load(myModel.fc3, "0fc3.pt");    
-    myModel.to(torch::kCUDA);
+    myModel.place(device);
 
     // At this point "game" variable is populated with initial map data.
     // This is a good place to do computationally expensive start-up pre-processing.
@@ -203,35 +193,65 @@ int main(int argc, char* argv[]) {
     game.ready("MyCppBot");
 
     log::log("Successfully created bot! My Player ID is " + to_string(game.my_id) + ". Bot rng seed is " + to_string(rng_seed) + ".");
+    if (!validOptions) {
+        log::log("ERROR: Ignored a bad --device, --intra-op-threads or --inter-op-threads value");
+    }
+    log::log(std::string("Running the network on the ") + (device.is_cuda() ? "GPU" : "CPU") + " with " + to_string(at::get_num_threads()) + " threads.");
 
 
-    int offset = 0;
+    //Reused every turn
+    std::vector<float> sharedFrames;
+    std::vector<float> shipFrames;
+    std::vector<std::shared_ptr<Ship>> ships;
+    std::vector<int64_t> actions;
+    torch::NoGradGuard noGrad;
+
     for (;;) {
         game.update_frame();
-        shared_ptr<Player> me = game.me;
+        //The turn's clock starts as soon as its frame has arrived
+        const auto turnStart = std::chrono::steady_clock::now();
+        const shared_ptr<Player> &me = game.me;
         unique_ptr<GameMap>& game_map = game.game_map;
 
         vector<Command> command_queue;
         auto gameState = parseGameIntoGameState(game);
 
+        ships.clear();
         for (const auto& ship_iterator : me->ships) {
+            ships.push_back(ship_iterator.second);
+        }
 
-            // Parse current ship into frames for our neural network
-            shared_ptr<Ship> ship = ship_iterator.second;
-
-            // Parse the map into inputs for our neural network
-            log::log("About to parse frames");
-            //auto gameState = parseGameIntoGameState(me->id, game, ship->position.y, ship->position.x, ship->halite);
-            auto entityState = parseGameIntoEntityState(gameState, me->id, ship->position.y, ship->position.x, ship->halite);
-            log::log("Done parsing frames");
-            auto state = convertEntityStateToTensor(entityState);
-            //Convert input frames into tensor state
-            state = state.unsqueeze(0);
+        //Every ship of the turn goes through the network at once: the shared frames are encoded once, and each
+        //chunk of ships is one forward pass whose sampled actions come back in one copy
+        actions.assign(ships.size(), DEFAULT_ACTION);
+        std::size_t decided = 0;
+        if(!ships.empty()) {
+            auto shared = convertGameStateToSharedTensor(*gameState, me->id, sharedFrames);
+            auto shipTensor = convertShipsToTensor(ships, shipFrames);
             torch::Tensor emptyAction;
-            auto result = myModel.forward(state, emptyAction);
-            // Convert to the game's interpreation
-            auto action = result.action.item<int64_t>();
-            log::log("Action: " + std::to_string(action));
+            std::chrono::steady_clock::duration slowestChunk{0};
+            while(decided < ships.size()) {
+                const auto chunkStart = std::chrono::steady_clock::now();
+                //Stop while the slowest pass so far still fits; the remaining ships keep the default action
+                if(chunkStart - turnStart + slowestChunk > TURN_BUDGET) {
+                    break;
+                }
+                const auto count = std::min(INFERENCE_CHUNK, ships.size() - decided);
+                auto sharedIndex = torch::zeros({static_cast<long>(count)}, torch::kLong);
+                auto result = myModel.forward(shared, sharedIndex, shipTensor.narrow(0, decided, count), emptyAction);
+                auto chunkActions = result.action.to(torch::kCPU).contiguous();
+                std::copy(chunkActions.data<int64_t>(), chunkActions.data<int64_t>() + count, actions.begin() + decided);
+                decided += count;
+                slowestChunk = std::max(slowestChunk, std::chrono::steady_clock::now() - chunkStart);
+            }
+        }
+        const std::chrono::duration<double, std::milli> inferenceTime = std::chrono::steady_clock::now() - turnStart;
+        log::log("Turn " + std::to_string(game.turn_number) + ": " + std::to_string(decided) + " of " + std::to_string(ships.size())
+                 + " ships decided by the network in " + std::to_string(inferenceTime.count()) + " ms");
+
+        for(std::size_t i = 0; i < ships.size(); i++) {
+            const auto &ship = ships[i];
+            const auto action = actions[i];
 
             // Send it 
             //std::string unitCommands[6] = {"N","E","S","W","still","construct"};
@@ -1,55 +1,55 @@
 #ifndef BATCHER_H
 #define BATCHER_H
 
+#include <algorithm>
 #include <cstdlib>
+#include <numeric>
+#include <random>
 #include <vector>
-#include "types.hpp"
+#include <torch/torch.h>
 
+/*
+ * Splits the steps of a rollout into shuffled minibatches of indices.
+ * Only a permutation of the step indices is shuffled; each minibatch is a slice of it, used to gather
+ * from tensors that were encoded once for the whole rollout with index_select.
+ */
 class Batcher {
 public:
-int batchSize;
-int numEntries;
-std::vector<ProcessedRolloutItem> data;
-std::vector<ProcessedRolloutItem>::iterator batchStart;
-std::vector<ProcessedRolloutItem>::iterator batchEnd;
+long batchSize;
+long numEntries;
+torch::Tensor permutation;
+long batchStart;
+std::vector<int64_t> order;     //The permutation on the host, reshuffled in place every round
 
-    Batcher(int batchSize, std::vector<ProcessedRolloutItem> data) {
+    Batcher(long batchSize, long numEntries, torch::Device device) {
         this->batchSize = batchSize;
-        this->data = data;
-        this->numEntries = data.size();
+        this->numEntries = numEntries;
+        this->permutation = torch::arange(numEntries, torch::TensorOptions().dtype(torch::kLong).device(device));
+        this->order.resize(numEntries);
+        std::iota(order.begin(), order.end(), int64_t(0));
         this->reset();
     }
 
     void reset() {
-        this->batchStart = data.begin();
-        this->batchEnd = data.begin();
-        advance(batchEnd, batchSize);
+        this->batchStart = 0;
     }
 
     bool end() {
-        return this->batchStart == this->data.end();
+        return this->batchStart >= this->numEntries;
     }
 
-    std::vector<ProcessedRolloutItem> next_batch(){
-        std::vector<ProcessedRolloutItem> batch;
-        batch.insert(batch.end(), batchStart, batchEnd);
-
-        batchStart = batchEnd; 
-
-        //Advance batchEnd to either the end of the next batch or
-        //to the end of the data, whichever comes first
-        for(int i = 0; i < batchSize; i++){
-            batchEnd = batchEnd + 1;
-            if(batchEnd == this->data.end()) {
-                break;
-            }
-        }
-
+    /*The indices of the next minibatch, which is smaller than batchSize only at the end of the permutation*/
+    torch::Tensor next_batch() {
+        auto length = std::min(batchSize, numEntries - batchStart);
+        auto batch = permutation.narrow(0, batchStart, length);
+        batchStart = batchStart + length;
         return batch;
     }
 
-    void shuffle() {
-        std::random_shuffle(this->data.begin(), this->data.end());
+    /*Shuffle with the caller's generator rather than torch's global one, so a seeded run sees the same minibatches*/
+    void shuffle(std::mt19937_64 &rng) {
+        std::shuffle(order.begin(), order.end(), rng);
+        this->permutation = torch::from_blob(order.data(), { numEntries }, torch::kLong).clone().to(permutation.device());
         this->reset();
     }
 };
@@ -0,0 +1,102 @@
+#ifndef DEVICE_H
+#define DEVICE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <ATen/Parallel.h>
+#include <torch/torch.h>
+
+/*
+ * Where the network runs and how many threads torch's CPU kernels use, shared by training and the bot.
+ * Networks are always built and loaded on the CPU, then placed on the selected device once.
+ */
+struct DeviceOptions {
+    std::string device = "auto";    //"cpu", "cuda", or "auto" for CUDA when a GPU is present and the CPU otherwise
+    int intraOpThreads = 0;         //Threads splitting up a single op such as a convolution; 0 keeps torch's default
+    int interOpThreads = 0;         //Threads running independent ops at the same time; 0 keeps torch's default
+};
+
+/*
+ * Read --device=, --intra-op-threads= and --inter-op-threads= from the command line, skipping any other argument.
+ * Returns false if one of them has a value that cannot be used: an unknown device, or a thread count that is not
+ * a whole non-negative number.
+ */
+inline bool parseDeviceOptions(int argc, char *argv[], DeviceOptions &options) {
+    for(int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+        const auto equals = argument.find('=');
+        if(equals == std::string::npos) {
+            continue;
+        }
+        const auto flag = argument.substr(0, equals);
+        const auto value = argument.substr(equals + 1);
+        if(flag == "--device") {
+            if(value != "cpu" && value != "cuda" && value != "auto") {
+                return false;
+            }
+            options.device = value;
+        }
+        else if(flag == "--intra-op-threads" || flag == "--inter-op-threads") {
+            long threads;
+            std::size_t parsed = 0;
+            try {
+                threads = std::stol(value, &parsed);
+            }
+            catch(const std::logic_error &) {
+                return false;
+            }
+            if(parsed != value.size() || threads < 0 || threads > std::numeric_limits<int>::max()) {
+                return false;
+            }
+            (flag == "--intra-op-threads" ? options.intraOpThreads : options.interOpThreads) = static_cast<int>(threads);
+        }
+    }
+    return true;
+}
+
+/*
+ * When no intra-op count was given, split the cores between the threads that run forward passes at the same time,
+ * such as the learner and each rollout worker. They all share torch's one intra-op pool, which by default is as big
+ * as the machine, so together they would ask for several times the cores there are.
+ */
+inline void shareIntraOpThreads(DeviceOptions &options, std::size_t concurrentThreads) {
+    if(options.intraOpThreads == 0) {
+        const std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+        options.intraOpThreads = static_cast<int>(std::max<std::size_t>(1, cores / std::max<std::size_t>(1, concurrentThreads)));
+    }
+}
+
+/*
+ * Size torch's CPU thread pools. Call once at startup, before torch runs anything:
+ * the inter-op pool can only be sized before it is first used.
+ */
+inline void configureThreads(const DeviceOptions &options) {
+    if(options.intraOpThreads > 0) {
+        at::set_num_threads(options.intraOpThreads);
+    }
+    if(options.interOpThreads > 0) {
+        at::set_num_interop_threads(options.interOpThreads);
+    }
+}
+
+/*
+ * The device to run the network on. Asking for CUDA where there is none warns on stderr, which the game protocol
+ * leaves free, and falls back to the CPU.
+ */
+inline torch::Device selectDevice(const DeviceOptions &options) {
+    if(options.device != "cpu" && torch::cuda::is_available()) {
+        return torch::Device(torch::kCUDA);
+    }
+    if(options.device == "cuda") {
+        std::cerr << "--device=cuda was given but CUDA is not available; running on the CPU" << std::endl;
+    }
+    return torch::Device(torch::kCPU);
+}
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef ADVANTAGE_HPP
+#define ADVANTAGE_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Compute discounted returns and generalized advantage estimates for a batch of steps from many ships and games.
+ *
+ * Each ship of each game is its own trajectory, identified by the pair (game, entity). The steps of a game must be
+ * contiguous and in turn order, with ships in any order within a turn; this is how rollouts are stored. A trajectory
+ * ends at the last step of its ship, or at any step whose done flag is 0, and is never bootstrapped past that.
+ *
+ * The steps are walked backwards once. A table indexed by entity remembers the value, return and advantage of the
+ * following step of each ship of the current game, so each step only reads its own entry.
+ *
+ * @param count The number of steps.
+ * @param game The game of each step.
+ * @param entity The ship of each step, unique within its game.
+ * @param reward The reward of each step.
+ * @param value The value estimated for each step.
+ * @param done 0 if the trajectory ends on this step, 1 otherwise.
+ * @param discount_rate The discount applied to each later step.
+ * @param tau The GAE smoothing factor.
+ * @param[out] returns The discounted return of each step.
+ * @param[out] advantages The advantage of each step.
+ */
+inline void compute_advantages(std::size_t count, const uint32_t *game, const int32_t *entity, const float *reward,
+                               const float *value, const uint8_t *done, float discount_rate, float tau,
+                               float *returns, float *advantages) {
+    /** What a ship's next step left behind for the step before it. */
+    struct Next {
+        uint32_t game;      /**< The game the entry belongs to, so entries of other games are ignored. */
+        bool valid;         /**< Whether there is a next step in the same trajectory. */
+        float value;        /**< The value estimated for the next step. */
+        float returns;      /**< The return of the next step. */
+        float advantage;    /**< The advantage of the next step. */
+    };
+    std::vector<Next> next;
+
+    const auto smoothing = discount_rate * tau;
+    for (std::size_t i = count; i-- > 0;) {
+        assert(entity[i] >= 0);
+        const auto slot = static_cast<std::size_t>(entity[i]);
+        if (slot >= next.size()) {
+            next.resize(slot + 1, Next{0, false, 0, 0, 0});
+        }
+        auto &following = next[slot];
+        const bool bootstrap = following.valid && following.game == game[i] && done[i] != 0;
+
+        const auto next_value = bootstrap ? following.value : 0.0f;
+        const auto next_return = bootstrap ? following.returns : 0.0f;
+        const auto next_advantage = bootstrap ? following.advantage : 0.0f;
+        const auto td_error = reward[i] + discount_rate * next_value - value[i];
+        returns[i] = reward[i] + discount_rate * next_return;
+        advantages[i] = td_error + smoothing * next_advantage;
+
+        following = Next{game[i], true, value[i], returns[i], advantages[i]};
+    }
+}
+
+/**
+ * Shift and scale advantages to zero mean and unit standard deviation.
+ * The mean and variance come from a single pass accumulating the sum and the sum of squares.
+ * @param count The number of advantages.
+ * @param advantages The advantages, normalized in place.
+ */
+inline void normalize_advantages(std::size_t count, float *advantages) {
+    if (count == 0) {
+        return;
+    }
+    double sum = 0;
+    double sum_of_squares = 0;
+    for (std::size_t i = 0; i < count; i++) {
+        sum += advantages[i];
+        sum_of_squares += static_cast<double>(advantages[i]) * advantages[i];
+    }
+    const auto mean = sum / count;
+    const auto variance = std::max(0.0, sum_of_squares / count - mean * mean);
+    const auto scale = static_cast<float>(1.0 / (std::sqrt(variance) + 1e-8));
+    const auto shift = static_cast<float>(mean);
+    for (std::size_t i = 0; i < count; i++) {
+        advantages[i] = (advantages[i] - shift) * scale;
+    }
+}
+
+#endif // ADVANTAGE_HPP
@@ -1,418 +1,164 @@
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
 #include <math.h>
 #include <iterator>
 #include <vector>
 #include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <tuple>
 
 #include "Constants.hpp"
 #include "Generator.hpp"
 #include "Halite.hpp"
 #include "Replay.hpp"
 #include "Enumerated.hpp"
+#include "SeedStream.hpp"
 #include "../types.hpp"
 #include "../batcher.hpp"
 #include "../model.hpp"
+#include "advantage.hpp"
+#include "mpsc_queue.hpp"
+#include "observation.hpp"
+#include "rollout_buffer.hpp"
+#include "rollout_worker.hpp"
 
 #include <torch/torch.h>
 
 class Agent {
 private:
 
-std::string unitCommands[5] = {"N","E","S","W","still"};
-
-torch::Tensor convertEntityStateToTensor(std::shared_ptr<EntityState> &entityStatePtr) {
-
-    auto entityState = entityStatePtr.get();
-    auto gameState = entityState->gameState.get();
-    auto playerId = entityState->playerId;
-
-    //Global info
-    auto steps_remaining = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
-    //My global info
-    auto my_ships = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
-    auto my_ships_halite = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
-    auto my_dropoffs = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
-    auto my_score = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
-    //Enemy global info
-    auto enemy_ships = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
-    auto enemy_ships_halite = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
-    auto enemy_dropoffs = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
-    auto enemy_score = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
-
-    //Ship specific information
-    auto entity_location = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
-    auto entity_energy = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
-
-    entity_location[entityState->entityY][entityState->entityX] = 1;
-    entity_energy[entityState->entityY][entityState->entityX] = entityState->halite_on_ship;
-
-    steps_remaining.fill_(gameState->steps_remaining);
-
-    //TODO: Generalize for more players
-    if(playerId == 0) {
-        my_score.fill_(gameState->scores[0]);
-        enemy_score.fill_(gameState->scores[1]);
-    } else {
-        my_score.fill_(gameState->scores[1]);
-        enemy_score.fill_(gameState->scores[0]);
-    }
-
-    float halite = -1.0;
-    float haliteLocationArray[GAME_HEIGHT][GAME_WIDTH];
-
-    for(std::size_t y = 0; y < GAME_HEIGHT; y++) {
-        for(std::size_t x = 0; x < GAME_WIDTH; x++) {
-            auto cell = gameState->position[y][x];
-            haliteLocationArray[y][x] = cell.halite_on_ground;
-
-            if(cell.shipOwnerId == playerId) {
-                my_ships[y][x] = 1;
-                my_ships_halite[y][x] = cell.halite_on_ship;
-            }
-            else if (cell.shipOwnerId != -1) {
-                enemy_ships[y][x] = 1;
-                enemy_ships_halite[y][x] = cell.halite_on_ship;
-                halite = cell.halite_on_ship;
-            }
-
-            if(cell.structureOwnerId == playerId) {
-                my_dropoffs[y][x] = 1;
-            }
-            else if (cell.structureOwnerId != -1) {
-                enemy_dropoffs[y][x] = 1;
-            }
-        }
-    }
-
-    auto halite_location = torch::from_blob(haliteLocationArray, {GAME_HEIGHT, GAME_WIDTH});
-    std::vector<torch::Tensor> frames {halite_location, steps_remaining,
-    my_ships, my_ships_halite, my_dropoffs, my_score,
-    enemy_ships, enemy_ships_halite, enemy_dropoffs, enemy_score,
-    entity_location, entity_energy};
-
-    auto stateTensor = torch::stack(frames);
-    return stateTensor;
-}
-
-std::shared_ptr<EntityState> parseGameIntoEntityState(std::shared_ptr<GameState> &gameState, long playerId, int entityY, int entityX, float entityEnergy) {
-    auto entityStatePtr = std::make_shared<EntityState>();
-    auto entityState = entityStatePtr.get();
-    
-    entityState->gameState = gameState;
-    entityState->entityY = entityY;
-    entityState->entityX = entityX;
-    entityState->halite_on_ship = (entityEnergy / MAX_HALITE_ON_SHIP) - 0.5;
-    entityState->playerId = playerId;
-
-    return entityStatePtr;
-}
-
-std::shared_ptr<GameState> parseGameIntoGameState(hlt::Halite &game) {
+CompleteRolloutResult generate_rollouts() {
 
-    auto gameStatePtr = std::make_shared<GameState>();
-    auto gameState = gameStatePtr.get();
+    int numberOfGamesPlayed = 0;
+    CompleteRolloutResult result;
+    std::vector<long> scores;
+    std::vector<long> gameSteps;
+    double totalStaleness = 0;
+    Trajectory longestGame;         //Only the scores and the seed and policy that replay it are kept
+    longestGame.gameSteps = -1;
 
-    int numRows = game.map.grid.size();
-    int totalSteps = 0;
-    if (numRows == 64) {
-        totalSteps = 501;
-    }
-    else if (numRows == 56) {
-        totalSteps = 476;
-    }
-    else if (numRows == 48) {
-        totalSteps = 451;
+    //Workers start on the first update, so they play whatever weights were loaded after construction
+    if(workers.empty()) {
+        start_workers();
     }
-    else if (numRows == 40) {
-        totalSteps = 426;
-    }
-    else {
-        totalSteps = 401;
-    }
-
-    int cellY = 0;
-    for(auto row : game.map.grid) {
-        int cellX = 0;
-        for (auto cell: row) {
-            auto x = cellX;
-            auto y = cellY;
-
-            float scaled_halite = (cell.energy / MAX_HALITE_ON_MAP) - 0.5;
-            gameState->position[y][x].halite_on_ground = scaled_halite;
 
-            if(cell.entity.value != -1) {
-                //There is a ship here
-                auto entity = game.store.get_entity(cell.entity);
-
-                gameState->position[y][x].halite_on_ship = (entity.energy / MAX_HALITE_ON_SHIP) - 0.5;
-                gameState->position[y][x].shipOwnerId = entity.owner.value;
-            }
-
-            cellX = cellX + 1;
+    //Drain the games finished by the rollout workers
+    rolloutBuffer.clear();
+    while(rolloutBuffer.size() < minimum_rollout_size) {
+        Trajectory trajectory;
+        if(!trajectories.try_pop(trajectory)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
         }
-        cellY = cellY + 1;
-    }
-
-    for(auto playerPair : game.store.players) {
 
-        auto player = playerPair.second;
-        auto spawn = player.factory;
-
-        //We consider spawn/factories to be both dropoffs and spawns
-        gameState->position[spawn.y][spawn.x].dropOffPresent = true;
-        gameState->position[spawn.y][spawn.x].spawnPresent = true;
-        gameState->position[spawn.y][spawn.x].structureOwnerId = player.id.value;
-
-        for(auto dropoff : player.dropoffs) {
-            gameState->position[dropoff.location.y][dropoff.location.x].dropOffPresent = true;
-            gameState->position[dropoff.location.y][dropoff.location.x].structureOwnerId = player.id.value;
+        //How many updates behind the current policy each action was chosen
+        for(auto version : trajectory.rollouts.policyVersion) {
+            totalStaleness += policyVersion - version;
         }
 
-        // Player score
-        auto score = player.energy;
-        auto floatScore = (float)score;
-        gameState->scores[player.id.value] = (floatScore / MAX_SCORE_APPROXIMATE) - 0.5;
-    }
+        //Workers number games by their own slots, so give each trajectory its own game number here
+        const auto firstStep = rolloutBuffer.size();
+        rolloutBuffer.append(trajectory.rollouts);
+        std::fill(rolloutBuffer.game.begin() + firstStep, rolloutBuffer.game.end(), static_cast<uint32_t>(numberOfGamesPlayed));
 
-    //Steps remaining
-    float steps_remaining_value = totalSteps - game.turn_number + 1;
-    auto scaled_steps = (steps_remaining_value / float(totalSteps)) - 0.5; //We normalize between [-0.5, 0.5]
-    gameState->steps_remaining = scaled_steps;
-
-    return gameStatePtr;
-}
-
-CompleteRolloutResult generate_rollouts() {
+        if(trajectory.gameSteps > longestGame.gameSteps) {
+            longestGame.scores = trajectory.scores;
+            longestGame.gameSteps = trajectory.gameSteps;
+            longestGame.seed = trajectory.seed;
+            longestGame.policyVersion = trajectory.policyVersion;
+        }
 
-    int numberOfGamesPlayed = 0;
-    CompleteRolloutResult result;
-    std::vector<RolloutItem> rollouts;
-    std::vector<long> scores;
-    std::vector<long> gameSteps;
-    const auto &constants = hlt::Constants::get();
-
-    while(rollouts.size() < minimum_rollout_size) {
-        //Reset environment for new game
-        long map_width = GAME_HEIGHT;
-        long map_height = GAME_WIDTH;
-        std::size_t numPlayers = 2;
-        hlt::mapgen::MapType type = hlt::mapgen::MapType::Fractal;
-        auto seed = static_cast<unsigned int>(time(nullptr));
-        hlt::mapgen::MapParameters map_parameters{type, seed, map_width, map_height, numPlayers};
-        hlt::Map map(map_width, map_height);
-        hlt::mapgen::Generator::generate(map, map_parameters);
-        hlt::GameStatistics game_statistics;
-        hlt::Replay replay{game_statistics, map_parameters.num_players, map_parameters.seed, map};
-        hlt::Halite game(map, game_statistics, replay);
-
-        game.initialize_game(numPlayers);
+        scores.insert(scores.end(), trajectory.scores.begin(), trajectory.scores.end());
+        gameSteps.push_back(trajectory.gameSteps);
         numberOfGamesPlayed = numberOfGamesPlayed + 1;
-
-        game.turn_number = 1;
-
-        while(true) {
-            // First, update inspiration flags, so they can be used for
-            // movement/mining and so they are part of the replay.
-            game.update_inspiration();
-
-            std::map<long, std::vector<AgentCommand>> commands;
-            std::unordered_map<hlt::Entity::id_type, RolloutItem> rolloutsForCurrentTurn;
-
-            auto &players = game.store.players;
-            auto gameState = parseGameIntoGameState(game);
-            //On every turn we reset the lookup for collected halite
-            game.store.energy_dropped_off.clear();
-
-            for (auto playerPair : players) {
-                auto playerId = playerPair.first.value;
-                auto player = playerPair.second;
-                std::vector<AgentCommand> playerCommands;
-
-                for(auto entityPair : player.entities) {
-                    auto entityId = entityPair.first;
-                    auto location = entityPair.second;
-                    auto entity = game.store.get_entity(entityId);
-
-                    auto entityState = parseGameIntoEntityState(gameState, playerId, location.y, location.x, entity.energy);
-                    auto state = convertEntityStateToTensor(entityState).unsqueeze(0);
-
-                    torch::Tensor emptyAction;
-                    //Ask the neural network what to do
-                    auto modelOutput = myModel.forward(state, emptyAction);
-                    auto actionIndex = modelOutput.action.item<int64_t>();
-
-                    //Create and story rollout
-                    RolloutItem current_rollout;
-                    current_rollout.state = entityState;
-                    current_rollout.value = modelOutput.value.item<float>();
-                    current_rollout.action = actionIndex;
-                    current_rollout.log_prob = modelOutput.log_prob.item<float>();
-                    current_rollout.playerId = playerId;
-                    current_rollout.reward = 0;
-                    //This seems backwards but we represent "Done" as 0 and "Not done" as 1
-                    current_rollout.done = 1;
-
-                    rolloutsForCurrentTurn[entityId] = current_rollout;
-                    std::string command = unitCommands[actionIndex];
-                    playerCommands.push_back(AgentCommand(entityId.value, command));
-                }
-
-                auto factoryCell = game.map.grid[player.factory.y][player.factory.x];
-                if(player.entities.size() == 0 && player.energy >= constants.NEW_ENTITY_ENERGY_COST && factoryCell.entity.value == -1) {
-                    std::string command = "spawn";
-                    playerCommands.push_back(AgentCommand(playerId, command));
-                }
-
-                commands[playerId] = playerCommands;
-            }
-
-            game.process_turn(commands);
-
-            for(auto &rolloutKeyPair : rolloutsForCurrentTurn) {
-                const auto entityId = rolloutKeyPair.first;
-                auto &rolloutItem = rolloutKeyPair.second;
-
-                //If any energy was dropped off by this entity
-                auto iterator = game.store.energy_dropped_off.find(entityId);
-                if(iterator != game.store.energy_dropped_off.end()) {
-                    auto energy = game.store.energy_dropped_off[entityId];
-                    rolloutItem.reward = energy;
-                }
-
-                rollouts.push_back(rolloutItem);
-            }
-
-            game.turn_number = game.turn_number + 1;
-            if (game.game_ended() || game.turn_number >= constants.MAX_TURNS) {
-
-                auto p1TurnProductions = game.game_statistics.player_statistics[0].turn_productions;
-                auto p2TurnProductions = game.game_statistics.player_statistics[1].turn_productions;
-                auto player1Score = p1TurnProductions[p1TurnProductions.size() - 1];
-                auto player2Score = p2TurnProductions[p2TurnProductions.size() - 1];
-
-                scores.push_back(player1Score);
-                scores.push_back(player2Score);
-
-                //std::cout << "Game ended in: " << game.turn_number << " turns" << std::endl;
-                gameSteps.push_back(game.turn_number);
-                break;
-            }
-        }
     }
 
-    std::cout << "Rollouts: " << rollouts.size() << std::endl;
+    std::cout << "Rollouts: " << rolloutBuffer.size() << std::endl;
+    std::cout << "Rollout memory: " << rolloutBuffer.memory_bytes() / 1024 << " KiB" << std::endl;
     std::cout << "Games played: " << numberOfGamesPlayed << std::endl;
+    std::cout << "Mean policy staleness: " << totalStaleness / rolloutBuffer.size() << std::endl;
+    //The one game of the update worth replaying: its map seed and policy version replay it
+    std::cout << "Longest game: seed " << longestGame.seed << " policy " << longestGame.policyVersion << " scores";
+    for(auto score : longestGame.scores) {
+        std::cout << " " << score;
+    }
+    std::cout << " in " << longestGame.gameSteps << " turns" << std::endl;
 
-    //Return scores along with rollouts
-    result.rollouts = rollouts;
+    //Return scores, the rollouts stay in rolloutBuffer
     result.scores = scores;
     result.gameSteps = gameSteps;
     return result;
 }
 
-std::vector<ProcessedRolloutItem> process_rollouts(std::vector<RolloutItem> rollouts) {
-    std::vector<ProcessedRolloutItem> processed_rollouts;
-
-    //Get last value
-    float advantage = 0;
-    auto currentReturn = rollouts[rollouts.size() - 1].value;
-
-    float advantage_mean = 0.0;
-
-    for(int i = rollouts.size() - 2;  i >= 0; i--) {
-        auto rolloutItem = rollouts[i];
-        auto nextValue = rollouts[i + 1].value;
+void process_rollouts(const RolloutBuffer &rollouts) {
+    const auto count = rollouts.size();
+    returns.resize(count);
+    advantages.resize(count);
 
-        currentReturn = rolloutItem.reward + this->discount_rate * rolloutItem.done * currentReturn;
-        auto td_error = rolloutItem.reward + this->discount_rate * rolloutItem.done * nextValue - rolloutItem.value;
-        advantage = advantage * this->tau * this->discount_rate * rolloutItem.done + td_error;
-
-        ProcessedRolloutItem processedRolloutItem;
-        processedRolloutItem.state = rolloutItem.state;
-        processedRolloutItem.action = rolloutItem.action;
-        processedRolloutItem.log_prob = rolloutItem.log_prob;
-        processedRolloutItem.returns = currentReturn;
-        processedRolloutItem.advantage = advantage;
-        processed_rollouts.push_back(processedRolloutItem);
-
-        advantage_mean = advantage_mean + advantage;   //Accumulate all advantages
-    }
-
-    //Calculate mean from sum of advantages
-    advantage_mean = advantage_mean / processed_rollouts.size();
-
-    float advantage_std;
-    for(std::size_t i = 0; i < processed_rollouts.size(); i++) {
-        auto rolloutItem = processed_rollouts[i];
-        auto differenceFromMean = (rolloutItem.advantage - advantage_mean);
-        advantage_std = advantage_std + (differenceFromMean * differenceFromMean);
-    }
-
-    //Calculate std from sum of squared differences
-    advantage_std = advantage_std / processed_rollouts.size();
-    advantage_std = sqrt(advantage_std);
+    //Every ship of every game is its own trajectory
+    compute_advantages(count, rollouts.game.data(), rollouts.entity.data(), rollouts.reward.data(), rollouts.value.data(),
+                       rollouts.done.data(), this->discount_rate, this->tau, returns.data(), advantages.data());
+    normalize_advantages(count, advantages.data());
+}
 
-    //Normalize all of the advantages
-    for(auto processedRolloutItem : processed_rollouts) {
-        processedRolloutItem.advantage = (processedRolloutItem.advantage - advantage_mean) / advantage_std;
+/*Publish the current weights as the first version and start the workers, each on its own substream of seeds*/
+void start_workers() {
+    policyVersion = policies.publish(myModel);
+    for(std::size_t i = 0; i < num_workers; i++) {
+        workers.push_back(std::make_unique<RolloutWorker>(policies, trajectories, games_per_worker, seeds.substream(1 + i)));
     }
-
-    return processed_rollouts;
 }
 
-TrainingResult train_network(std::vector<ProcessedRolloutItem> processed_rollout) {
+TrainingResult train_network(const RolloutBuffer &rollouts) {
 
     std::vector<float> value_losses;
     std::vector<float> policy_losses;
     std::vector<float> losses;
 
-    float sampled_actions[this->mini_batch_number];
-    float sampled_log_probs_old[this->mini_batch_number];
-    float sampled_returns[this->mini_batch_number];
-    float sampled_advantages[this->mini_batch_number];
-
-    Batcher batcher(std::min(this->mini_batch_number, processed_rollout.size()), processed_rollout);
+    //Encode every step once and move it to the device; minibatches are gathered from these tensors
+    const auto count = static_cast<long>(rollouts.size());
+    batchSteps.resize(count);
+    std::iota(batchSteps.begin(), batchSteps.end(), std::size_t(0));
+    auto observations = encodeSteps(rollouts, batchSteps, observationBuffers);
+    auto shared = observations.shared.to(device);
+    auto sharedIndex = observations.sharedIndex.to(device);
+    auto ship = observations.ship.to(device);
+
+    auto actions = torch::from_blob(const_cast<uint8_t *>(rollouts.action.data()), { count }, torch::kByte).to(device).toType(torch::kLong).unsqueeze(-1);
+    auto log_probs_old = torch::from_blob(const_cast<float *>(rollouts.logProb.data()), { count, 1 }).to(device);
+    auto returns_tensor = torch::from_blob(returns.data(), { count, 1 }).to(device);
+    auto advantages_tensor = torch::from_blob(advantages.data(), { count, 1 }).to(device);
+
+    Batcher batcher(std::min(static_cast<long>(this->mini_batch_number), count), count, device);
     for(int i = 0; i < this->learningRounds; i++) {
         //Shuffle the rollouts
-        batcher.shuffle();
+        batcher.shuffle(shuffleRng);
 
         while(!batcher.end()) {
-            auto nextBatch = batcher.next_batch();
-            auto batchSize = (long)(nextBatch.size());
-
-            for(int i = 0; i < batchSize; i++) {
-                sampled_actions[i] = nextBatch[i].action;
-                sampled_log_probs_old[i] = nextBatch[i].log_prob;
-                sampled_returns[i] = nextBatch[i].returns;
-                sampled_advantages[i] = nextBatch[i].advantage;
-            }
-
-            //Create stack of Tensors as input to neural network
-            std::vector<at::Tensor> stateList;
-            for(int i = 0; i < batchSize; i++) {
-                auto entityState = nextBatch[i].state;
-                auto stateTensor = convertEntityStateToTensor(entityState);
-                stateList.push_back(stateTensor);
-            }
-
-            auto batchInput = torch::stack(stateList);
-            auto actionsTensor = torch::from_blob(sampled_actions, { batchSize });
-            actionsTensor = actionsTensor.toType(torch::ScalarType::Long).unsqueeze(-1);
-
-            auto modelOutput = this->myModel.forward(batchInput, actionsTensor);
+            auto batch = batcher.next_batch();
+
+            //Only the shared rows used by this minibatch go through the network
+            auto batchSharedIndex = sharedIndex.index_select(0, batch);
+            torch::Tensor sharedRows, batchSharedRow;
+            std::tie(sharedRows, batchSharedRow) = torch::_unique(batchSharedIndex, /*sorted=*/true, /*return_inverse=*/true);
+
+            auto modelOutput = this->myModel.forward(shared.index_select(0, sharedRows), batchSharedRow, ship.index_select(0, batch), actions.index_select(0, batch));
             auto log_probs = modelOutput.log_prob;
             auto values = modelOutput.value;
             auto entropy = modelOutput.entropy;
 
-            auto sampled_advantages_tensor = torch::from_blob(sampled_advantages, { batchSize, 1}).to(device);
-            auto ratio = (log_probs - torch::from_blob(sampled_log_probs_old, { batchSize, 1}).to(device)).exp();
+            auto sampled_advantages_tensor = advantages_tensor.index_select(0, batch);
+            auto ratio = (log_probs - log_probs_old.index_select(0, batch)).exp();
             auto obj = ratio * sampled_advantages_tensor;
             auto obj_clipped = ratio.clamp(1.0 - ppo_clip, 1.0 + ppo_clip) * sampled_advantages_tensor;
             auto policy_loss = -torch::min(obj, obj_clipped).mean();
 
             // TODO: Why do they do 0.5?
-            auto sampled_returns_tensor = torch::from_blob(sampled_returns, {batchSize, 1}).to(device);
+            auto sampled_returns_tensor = returns_tensor.index_select(0, batch);
             auto value_loss = 0.5 * (sampled_returns_tensor - values).pow(2).mean();
             auto entropy_loss = entropy_weight * entropy.mean();
 
@@ -437,23 +183,37 @@ TrainingResult train_network(std::vector<ProcessedRolloutItem> processed_rollout
 
 public:
     ActorCriticNetwork myModel;
-    torch::Device device;
+    torch::Device device;           //Where the learner trains, picked by selectDevice
 
     float discount_rate;            //Amount by which to discount future rewards
     float tau;                      //
-    int learningRounds;             //number of optimization rounds for a single rollout
+    int learningRounds;             //number of optimization rounds (epochs) over a single rollout
     std::size_t mini_batch_number;  //batch size for optimization
     float ppo_clip;                 //Clip gradient to try to prevent unstable learning
     //int gradient_clip;
     std::size_t minimum_rollout_size;       //Minimum number of rollouts we accumulate before training the network
     float learning_rate;            //Rate at which the network learns
     float entropy_weight;
+    std::size_t num_workers;        //Number of threads generating rollouts
+    std::size_t games_per_worker;   //Number of games each rollout thread plays in lockstep
     
     torch::optim::Adam optimizer;
 
-    Agent(float discount_rate, float tau, float learningRounds, float mini_batch_number, float ppo_clip, float minimum_rollout_size, float learning_rate, float entropy_weight):
+    hlt::SeedStream seeds;                      //Every random choice of the run derives from this stream
+    std::mt19937_64 shuffleRng;                 //Orders the minibatches of each learning round
+    BoundedMpscQueue<Trajectory> trajectories;  //Finished games waiting to be trained on
+    PolicyStore policies;                       //Weights published to the rollout workers
+    long policyVersion = -1;                    //Version of the weights being trained, -1 until the workers start
+    RolloutBuffer rolloutBuffer;                    //Rollouts of the current update
+    std::vector<float> returns;                     //Return of each step of rolloutBuffer
+    std::vector<float> advantages;                  //Normalized advantage of each step of rolloutBuffer
+    std::vector<std::size_t> batchSteps;            //Steps to encode for training, reused every update
+    SplitObservationBuffers observationBuffers;     //Network input of every step of the update, reused every update
+    std::vector<std::unique_ptr<RolloutWorker>> workers;    //Declared last so they stop before the queue goes away
+
+    Agent(float discount_rate, float tau, float learningRounds, float mini_batch_number, float ppo_clip, float minimum_rollout_size, float learning_rate, float entropy_weight, std::size_t num_workers, std::size_t games_per_worker, std::uint64_t seed, torch::Device device):
         myModel(true),
-        device(torch::Device(torch::kCUDA)),
+        device(device),
         discount_rate(discount_rate),
         tau(tau),
         learningRounds(learningRounds),
@@ -462,9 +222,14 @@ public:
         minimum_rollout_size(minimum_rollout_size),
         learning_rate(learning_rate),
         entropy_weight(entropy_weight),
-        optimizer(myModel.parameters(), torch::optim::AdamOptions(learning_rate))
+        num_workers(num_workers),
+        games_per_worker(games_per_worker),
+        optimizer(myModel.parameters(), torch::optim::AdamOptions(learning_rate)),
+        seeds(seed),
+        shuffleRng(seeds.at(0)),
+        trajectories(64)
     {
-        myModel.to(device);
+        myModel.place(device);
 
         //Print out hyperparameter information
         std::cout << "discount_rate: " << discount_rate << std::endl;
@@ -475,6 +240,11 @@ public:
         //std::cout << "gradient_clip: " << gradient_clip << std::endl;
         std::cout << "minimum_rollout_size : " << minimum_rollout_size << std::endl;
         std::cout << "learning_rate: " << learning_rate << std::endl;
+        std::cout << "num_workers: " << num_workers << std::endl;
+        std::cout << "games_per_worker: " << games_per_worker << std::endl;
+        std::cout << "seed: " << seed << std::endl;
+        std::cout << "device: " << (device.is_cuda() ? "cuda" : "cpu") << std::endl;
+        std::cout << "intra_op_threads: " << at::get_num_threads() << std::endl;
     }
 
     StepResult step() {
@@ -488,17 +258,9 @@ public:
         scores.insert(scores.end(), rolloutResult.scores.begin(), rolloutResult.scores.end());
         gameSteps.insert(gameSteps.end(), rolloutResult.gameSteps.begin(), rolloutResult.gameSteps.end());
 
-        auto processed_ship_rollout = process_rollouts(rolloutResult.rollouts);
-
-        //Shuffle the rollouts
-        std::random_shuffle(processed_ship_rollout.begin(), processed_ship_rollout.end());
-        
-        //Sample a portion of the rollout on which to train
-        // auto sample_ship_start = processed_ship_rollout.begin();
-        // auto sample_ship_end = processed_ship_rollout.begin() + std::min(std::size_t(1000), processed_ship_rollout.size() -1);
-        // std::vector<ProcessedRolloutItem> sampled_ship_rollout(sample_ship_start, sample_ship_end);
-
-        auto currentLosses = train_network(processed_ship_rollout);
+        process_rollouts(rolloutBuffer);
+        auto currentLosses = train_network(rolloutBuffer);
+        policyVersion = policies.publish(myModel);
 
         StepResult result;
         result.meanScore = std::accumulate(scores.begin(), scores.end(), 0.0) / scores.size(); 
@@ -0,0 +1,246 @@
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <regex>
+#include <sstream>
+#include <thread>
+
+#include "Benchmark.hpp"
+
+/**
+ * Runner of halite_bench: runs every registered benchmark, or those matching a filter, and reports the time per
+ * iteration as a table or as Google Benchmark's JSON.
+ *
+ * Usage: halite_bench [--benchmark_filter=REGEX] [--benchmark_min_time=SECONDS] [--benchmark_format=console|json]
+ *                     [--benchmark_out=FILE]
+ * With --benchmark_out, the table still goes to the console and the JSON goes to the file.
+ */
+
+namespace bench {
+
+namespace {
+
+/** The settings of a run. */
+struct Options {
+    std::string filter = ".";       /**< Only benchmarks whose full name matches this run. */
+    double min_time = 0.5;          /**< The shortest timed run whose result is reported, in seconds. */
+    bool json = false;              /**< Whether to report JSON rather than a table on the console. */
+    std::string out;                /**< The file to write JSON to, if any. */
+};
+
+/** The result of one benchmark with one list of arguments. */
+struct Result {
+    std::string name;           /**< The name, followed by the arguments. */
+    uint64_t iterations;        /**< The iterations of the reported run. */
+    double real_time;           /**< Wall time per iteration, in nanoseconds. */
+    double cpu_time;            /**< Processor time per iteration, in nanoseconds. */
+    double items_per_second;    /**< Items processed per second, or 0 if the benchmark counts none. */
+};
+
+/** Get the registered benchmarks. */
+std::vector<std::unique_ptr<Benchmark>> &benchmarks() {
+    static std::vector<std::unique_ptr<Benchmark>> all;
+    return all;
+}
+
+/**
+ * Parse the command line.
+ * @param argc The number of arguments.
+ * @param argv The arguments.
+ * @param[out] options The settings.
+ * @return True if the arguments are valid.
+ */
+bool parse_options(int argc, char *argv[], Options &options) {
+    try {
+        for (int index = 1; index < argc; index++) {
+            const std::string argument = argv[index];
+            const auto equals = argument.find('=');
+            if (equals == std::string::npos) {
+                return false;
+            }
+            const auto flag = argument.substr(0, equals);
+            const auto value = argument.substr(equals + 1);
+            if (flag == "--benchmark_filter") {
+                options.filter = value;
+            } else if (flag == "--benchmark_min_time") {
+                options.min_time = std::stod(value);
+            } else if (flag == "--benchmark_format" && (value == "console" || value == "json")) {
+                options.json = value == "json";
+            } else if (flag == "--benchmark_out") {
+                options.out = value;
+            } else {
+                return false;
+            }
+        }
+    } catch (const std::exception &) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Run a benchmark with more and more iterations, until a run takes at least the minimum time.
+ * @param benchmark The benchmark.
+ * @param name The full name of the run.
+ * @param arguments The arguments.
+ * @param min_time The minimum time, in seconds.
+ * @return The result of the last run.
+ */
+Result run(const Benchmark &benchmark, const std::string &name, const std::vector<long> &arguments,
+           double min_time) {
+    uint64_t iterations = 1;
+    while (true) {
+        State state(arguments, iterations);
+        benchmark.function(state);
+        const auto seconds = state.real_seconds();
+        if (seconds >= min_time || iterations >= 1000000000) {
+            const auto count = static_cast<double>(iterations);
+            return {name, iterations, seconds * 1e9 / count, state.cpu_seconds() * 1e9 / count,
+                    state.items_processed() > 0 ? state.items_processed() / seconds : 0.0};
+        }
+        // Aim a little past the minimum time, growing at most tenfold from a run too short to go by.
+        const auto scale = seconds > 0 ? 1.4 * min_time / seconds : 10.0;
+        iterations = std::max(iterations + 1, static_cast<uint64_t>(iterations * std::min(scale, 10.0)));
+    }
+}
+
+/**
+ * Escape a string for JSON.
+ * @param text The string.
+ * @return The escaped string, in quotes.
+ */
+std::string quoted(const std::string &text) {
+    std::string escaped = "\"";
+    for (const auto character : text) {
+        if (character == '"' || character == '\\') {
+            escaped += '\\';
+        }
+        escaped += character;
+    }
+    return escaped + "\"";
+}
+
+/**
+ * Write results in the JSON format of Google Benchmark.
+ * @param out The stream to write to.
+ * @param results The results.
+ */
+void write_json(std::ostream &out, const std::vector<Result> &results) {
+    char date[32];
+    const auto now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+#ifdef NDEBUG
+    const char *build_type = "release";
+#else
+    const char *build_type = "debug";
+#endif
+#ifdef HALITE_PROFILE
+    const char *profiled = "true";
+#else
+    const char *profiled = "false";
+#endif
+
+    out << "{\n  \"context\": {\n"
+        << "    \"date\": " << quoted(date) << ",\n"
+        << "    \"executable\": \"halite_bench\",\n"
+        << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+        << "    \"library_build_type\": " << quoted(build_type) << ",\n"
+        << "    \"halite_profile\": " << profiled << "\n"
+        << "  },\n  \"benchmarks\": [";
+    out << std::setprecision(12);
+    for (std::size_t index = 0; index < results.size(); index++) {
+        const auto &result = results[index];
+        out << (index == 0 ? "\n" : ",\n") << "    {\n"
+            << "      \"name\": " << quoted(result.name) << ",\n"
+            << "      \"run_name\": " << quoted(result.name) << ",\n"
+            << "      \"run_type\": \"iteration\",\n"
+            << "      \"repetitions\": 1,\n"
+            << "      \"repetition_index\": 0,\n"
+            << "      \"threads\": 1,\n"
+            << "      \"iterations\": " << result.iterations << ",\n"
+            << "      \"real_time\": " << result.real_time << ",\n"
+            << "      \"cpu_time\": " << result.cpu_time << ",\n";
+        if (result.items_per_second > 0) {
+            out << "      \"items_per_second\": " << result.items_per_second << ",\n";
+        }
+        out << "      \"time_unit\": \"ns\"\n    }";
+    }
+    out << "\n  ]\n}\n";
+}
+
+/**
+ * Write one result as a row of the console table.
+ * @param result The result.
+ */
+void write_row(const Result &result) {
+    std::cout << std::left << std::setw(40) << result.name << std::right << std::fixed << std::setprecision(0)
+              << std::setw(14) << result.real_time << std::setw(14) << result.cpu_time
+              << std::setw(14) << result.iterations;
+    if (result.items_per_second > 0) {
+        std::cout << std::setw(16) << result.items_per_second;
+    }
+    std::cout << std::endl;
+}
+
+}
+
+/**
+ * Register a benchmark.
+ * @param name The name to report it under.
+ * @param function The function.
+ * @return The benchmark, to add runs to.
+ */
+Benchmark *register_benchmark(const std::string &name, std::function<void(State &)> function) {
+    benchmarks().push_back(std::make_unique<Benchmark>(Benchmark{name, std::move(function), {}}));
+    return benchmarks().back().get();
+}
+
+}
+
+int main(int argc, char *argv[]) {
+    bench::Options options;
+    if (!bench::parse_options(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0] << " [--benchmark_filter=REGEX] [--benchmark_min_time=SECONDS]"
+                  << " [--benchmark_format=console|json] [--benchmark_out=FILE]" << std::endl;
+        return 1;
+    }
+    const std::regex filter(options.filter);
+    const bool table = !options.json || !options.out.empty();
+
+    if (table) {
+        std::cout << std::left << std::setw(40) << "benchmark" << std::right << std::setw(14) << "time (ns)"
+                  << std::setw(14) << "cpu (ns)" << std::setw(14) << "iterations" << std::setw(16) << "items/s"
+                  << std::endl;
+    }
+    std::vector<bench::Result> results;
+    for (const auto &benchmark : bench::benchmarks()) {
+        auto argument_lists = benchmark->argument_lists;
+        if (argument_lists.empty()) {
+            argument_lists.emplace_back();
+        }
+        for (const auto &arguments : argument_lists) {
+            auto name = benchmark->name;
+            for (const auto argument : arguments) {
+                name += "/" + std::to_string(argument);
+            }
+            if (!std::regex_search(name, filter)) {
+                continue;
+            }
+            results.push_back(bench::run(*benchmark, name, arguments, options.min_time));
+            if (table) {
+                bench::write_row(results.back());
+            }
+        }
+    }
+
+    if (!options.out.empty()) {
+        std::ofstream out(options.out);
+        bench::write_json(out, results);
+    } else if (options.json) {
+        bench::write_json(std::cout, results);
+    }
+    return 0;
+}
@@ -0,0 +1,186 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * A small benchmark harness in the style of Google Benchmark, for halite_bench.
+ *
+ * A benchmark is a function of a State. It does its setup, then loops over the State; only the loop is timed:
+ *
+ *     void process_turn(bench::State &state) {
+ *         ...setup...
+ *         for (auto _ : state) { ...code to time... }
+ *     }
+ *     HALITE_BENCHMARK(process_turn)->args({10, 32})->args({50, 32});
+ *
+ * The runner repeats the function with more iterations until a run takes long enough to trust, and reports the
+ * time per iteration of that run, as text or as Google Benchmark's JSON so its tools can compare two commits.
+ */
+
+namespace bench {
+
+using clock_type = std::chrono::steady_clock;
+
+/** The state of one run of a benchmark: its arguments, the iterations to run and the time they took. */
+class State {
+    std::vector<long> arguments;
+    uint64_t iterations;
+    uint64_t items{};
+    clock_type::time_point start{};
+    std::clock_t cpu_start{};
+    std::chrono::duration<double> elapsed{};
+    double cpu_elapsed{};
+    bool running = false;
+
+    /** Start or resume the timers. */
+    void start_timers() {
+        running = true;
+        cpu_start = std::clock();
+        start = clock_type::now();
+    }
+
+    /** Stop or pause the timers, adding the time since they started. */
+    void stop_timers() {
+        if (running) {
+            elapsed += clock_type::now() - start;
+            cpu_elapsed += static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+            running = false;
+        }
+    }
+
+public:
+    /** What the loop yields; there is nothing to use. */
+    struct [[maybe_unused]] Value {};
+
+    /** Counts down the iterations, starting the timers on the first and stopping them after the last. */
+    class Iterator {
+        State *state;
+        uint64_t remaining;
+
+    public:
+        Iterator(State *state, uint64_t remaining) : state(state), remaining(remaining) {}
+
+        Value operator*() const { return {}; }
+
+        Iterator &operator++() {
+            remaining--;
+            return *this;
+        }
+
+        bool operator!=(const Iterator &) {
+            if (remaining != 0) {
+                return true;
+            }
+            state->stop_timers();
+            return false;
+        }
+    };
+
+    /**
+     * Construct a State.
+     * @param arguments The arguments of the run.
+     * @param iterations The number of iterations to run.
+     */
+    State(std::vector<long> arguments, uint64_t iterations) : arguments(std::move(arguments)), iterations(iterations) {}
+
+    Iterator begin() {
+        start_timers();
+        return {this, iterations};
+    }
+
+    Iterator end() { return {this, 0}; }
+
+    /**
+     * Get an argument of the run.
+     * @param index The position of the argument.
+     * @return The argument.
+     */
+    long range(std::size_t index) const { return arguments.at(index); }
+
+    /** Stop timing, for work an iteration needs but should not be measured, such as restoring a position. */
+    void pause_timing() { stop_timers(); }
+
+    /** Resume timing after pause_timing. */
+    void resume_timing() { start_timers(); }
+
+    /**
+     * Set the number of items all iterations processed, so items per second are reported too.
+     * @param count The number of items.
+     */
+    void set_items_processed(uint64_t count) { items = count; }
+
+    /** @return The number of iterations of the run. */
+    uint64_t max_iterations() const { return iterations; }
+
+    /** @return The items processed. */
+    uint64_t items_processed() const { return items; }
+
+    /** @return The wall time of the timed iterations, in seconds. */
+    double real_seconds() const { return elapsed.count(); }
+
+    /** @return The processor time of the timed iterations, in seconds. */
+    double cpu_seconds() const { return cpu_elapsed; }
+};
+
+/** A registered benchmark and the argument lists to run it with. */
+struct Benchmark {
+    std::string name;                           /**< The name of the function. */
+    std::function<void(State &)> function;      /**< The function. */
+    std::vector<std::vector<long>> argument_lists; /**< The arguments of each run; none means one run without. */
+
+    /**
+     * Add a run with one argument.
+     * @param value The argument.
+     * @return This benchmark, to chain more runs.
+     */
+    Benchmark *arg(long value) {
+        argument_lists.push_back({value});
+        return this;
+    }
+
+    /**
+     * Add a run with several arguments.
+     * @param values The arguments.
+     * @return This benchmark, to chain more runs.
+     */
+    Benchmark *args(std::initializer_list<long> values) {
+        argument_lists.emplace_back(values);
+        return this;
+    }
+};
+
+/**
+ * Register a benchmark.
+ * @param name The name to report it under.
+ * @param function The function.
+ * @return The benchmark, to add runs to.
+ */
+Benchmark *register_benchmark(const std::string &name, std::function<void(State &)> function);
+
+/**
+ * Keep the compiler from discarding a value the benchmark computes but does not use.
+ * @param value The value.
+ */
+template<class T>
+inline void do_not_optimize(const T &value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+}
+
+#define HALITE_BENCHMARK_CONCAT_(prefix, line) prefix##line
+#define HALITE_BENCHMARK_NAME_(line) HALITE_BENCHMARK_CONCAT_(halite_benchmark_, line)
+
+/** Register a function as a benchmark, under its own name. */
+#define HALITE_BENCHMARK(function) \
+    static ::bench::Benchmark *HALITE_BENCHMARK_NAME_(__LINE__) = ::bench::register_benchmark(#function, function)
+
+#endif // BENCHMARK_HPP
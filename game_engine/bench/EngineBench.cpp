@@ -0,0 +1,173 @@
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "Generator.hpp"
+#include "Halite.hpp"
+#include "Replay.hpp"
+#include "ScriptedBot.hpp"
+#include "advantage.hpp"
+
+/**
+ * Benchmarks of the engine's hot paths for halite_bench: map generation, turns at several ship densities,
+ * inspiration, and the advantage pass over a rollout. Every position comes from a fixed seed, so two commits are
+ * timed on the same games.
+ */
+
+namespace {
+
+constexpr unsigned long PLAYERS = 4;
+constexpr unsigned int SEED = 1;
+
+/** A game between greedy miners on its own map, with the default rules. */
+struct BenchGame {
+    hlt::Map map;
+    hlt::GameStatistics statistics;
+    std::unique_ptr<hlt::Replay> replay;
+    std::unique_ptr<hlt::Halite> halite;
+    std::vector<hlt::ScriptedBot> bots;
+    hlt::TurnCommands commands;
+
+    explicit BenchGame(long size) : map(size, size) {
+        hlt::mapgen::MapParameters parameters{hlt::mapgen::MapType::Fractal, SEED, size, size, PLAYERS};
+        hlt::mapgen::Generator::generate(map, parameters);
+        replay = std::make_unique<hlt::Replay>(statistics, PLAYERS, SEED, map);
+        halite = std::make_unique<hlt::Halite>(map, statistics, *replay);
+        halite->initialize_game(static_cast<int>(PLAYERS));
+        halite->turn_number = 1;
+        for (unsigned int seat = 0; seat < PLAYERS; seat++) {
+            bots.emplace_back(hlt::BotKind::GreedyMiner, seat);
+        }
+    }
+
+    /** Choose the commands of the coming turn into commands. */
+    void choose() {
+        halite->update_inspiration();
+        commands.clear(halite->store.players.size());
+        for (const auto &[player_id, player] : halite->store.players) {
+            bots[player_id.value].play(*halite, player, commands);
+        }
+    }
+
+    /**
+     * Play on to a point of the game, when the ships of that stage are on the map.
+     * @param percent How far through the game to play, as a percentage of its turns.
+     */
+    void play_to(long percent) {
+        const auto last_turn = halite->config.MAX_TURNS * percent / 100;
+        while (halite->turn_number < last_turn && !halite->game_ended()) {
+            choose();
+            halite->process_turn(commands);
+            halite->turn_number++;
+        }
+        choose();
+    }
+};
+
+/**
+ * Generate a map of one type, on a new map as each game does; generating adds factories to those already placed.
+ * @param state The argument is the width and height of the map.
+ * @param type The type of map.
+ */
+void generate_map(bench::State &state, hlt::mapgen::MapType type) {
+    const auto size = state.range(0);
+    hlt::mapgen::MapParameters parameters{type, SEED, size, size, PLAYERS};
+    for (auto _ : state) {
+        hlt::Map map(size, size);
+        hlt::mapgen::Generator::generate(map, parameters);
+        bench::do_not_optimize(map.grid.data());
+    }
+}
+
+void generate_basic(bench::State &state) {
+    generate_map(state, hlt::mapgen::MapType::Basic);
+}
+HALITE_BENCHMARK(generate_basic)->arg(32)->arg(48)->arg(64);
+
+void generate_blur_tile(bench::State &state) {
+    generate_map(state, hlt::mapgen::MapType::BlurTile);
+}
+HALITE_BENCHMARK(generate_blur_tile)->arg(32)->arg(48)->arg(64);
+
+void generate_fractal(bench::State &state) {
+    generate_map(state, hlt::mapgen::MapType::Fractal);
+}
+HALITE_BENCHMARK(generate_fractal)->arg(32)->arg(48)->arg(64);
+
+/**
+ * Process the same turn over and over, restoring the position before each, untimed.
+ * @param state The arguments are how far into the game the turn is, in percent, and the size of the map.
+ * Items are ships moved.
+ */
+void process_turn(bench::State &state) {
+    BenchGame game(state.range(1));
+    game.play_to(state.range(0));
+    const auto snapshot = game.halite->snapshot();
+    const auto ships = game.halite->store.entities.size();
+    for (auto _ : state) {
+        state.pause_timing();
+        game.halite->restore(snapshot);
+        state.resume_timing();
+        game.halite->process_turn(game.commands);
+    }
+    state.set_items_processed(state.max_iterations() * ships);
+}
+HALITE_BENCHMARK(process_turn)->args({10, 32})->args({50, 32})->args({90, 32})
+                              ->args({10, 64})->args({50, 64})->args({90, 64});
+
+/**
+ * Bring inspiration up to date after one turn of moves, as at the start of every turn.
+ * @param state The argument is the size of the map, mid-game. Items are ships.
+ */
+void update_inspiration(bench::State &state) {
+    BenchGame game(state.range(0));
+    game.play_to(50);
+    const auto snapshot = game.halite->snapshot();
+    const auto ships = game.halite->store.entities.size();
+    for (auto _ : state) {
+        state.pause_timing();
+        game.halite->restore(snapshot);
+        game.halite->update_inspiration();
+        game.halite->process_turn(game.commands);
+        state.resume_timing();
+        game.halite->update_inspiration();
+    }
+    state.set_items_processed(state.max_iterations() * ships);
+}
+HALITE_BENCHMARK(update_inspiration)->arg(32)->arg(48)->arg(64);
+
+/**
+ * Compute the returns and normalized advantages of a rollout, as the agent does before each update.
+ * @param state The argument is the number of steps. Items are steps.
+ */
+void process_rollouts(bench::State &state) {
+    // Games of 400 turns with 40 ships each, stored turn by turn as the workers store them.
+    static constexpr std::size_t TURNS = 400;
+    static constexpr std::size_t SHIPS = 40;
+    const auto count = static_cast<std::size_t>(state.range(0));
+    std::vector<uint32_t> game(count);
+    std::vector<int32_t> entity(count);
+    std::vector<float> reward(count), value(count), returns(count), advantages(count);
+    std::vector<uint8_t> done(count);
+    std::mt19937 rng(SEED);
+    std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+    for (std::size_t step = 0; step < count; step++) {
+        const auto turn = step / SHIPS;
+        game[step] = static_cast<uint32_t>(turn / TURNS);
+        entity[step] = static_cast<int32_t>(step % SHIPS);
+        reward[step] = rng() % 8 == 0 ? uniform(rng) : 0.0f;
+        value[step] = uniform(rng);
+        done[step] = turn % TURNS == TURNS - 1 ? 0 : 1;
+    }
+    for (auto _ : state) {
+        compute_advantages(count, game.data(), entity.data(), reward.data(), value.data(), done.data(), 0.99f, 0.95f,
+                           returns.data(), advantages.data());
+        normalize_advantages(count, advantages.data());
+        bench::do_not_optimize(advantages.data());
+    }
+    state.set_items_processed(state.max_iterations() * count);
+}
+HALITE_BENCHMARK(process_rollouts)->arg(1 << 12)->arg(1 << 16);
+
+}
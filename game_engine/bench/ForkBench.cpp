@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#define HALITE_COUNT_ALLOCATIONS
+#include "AllocationCounter.hpp"
+
+#include "GameFork.hpp"
+#include "Generator.hpp"
+#include "Halite.hpp"
+#include "Replay.hpp"
+
+/**
+ * Benchmark of forking a mid-game position: forks per second and the memory each fork allocates, restores of an
+ * existing fork per second, and turns of lookahead per second with one fork per thread.
+ */
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr unsigned long PLAYERS = 4;
+constexpr int OPENING_TURNS = 150;
+constexpr int LOOKAHEAD_TURNS = 4;
+
+/** A game on its own map, as the environments set one up. */
+struct BenchGame {
+    hlt::Map map;
+    hlt::GameStatistics statistics;
+    std::unique_ptr<hlt::Replay> replay;
+    std::unique_ptr<hlt::Halite> halite;
+
+    BenchGame(unsigned int seed, long size) : map(size, size) {
+        hlt::mapgen::MapParameters parameters{hlt::mapgen::MapType::Fractal, seed, size, size, PLAYERS};
+        hlt::mapgen::Generator::generate(map, parameters);
+        replay = std::make_unique<hlt::Replay>(statistics, PLAYERS, seed, map);
+        halite = std::make_unique<hlt::Halite>(map, statistics, *replay);
+        halite->initialize_game(static_cast<int>(PLAYERS));
+        halite->turn_number = 1;
+    }
+};
+
+/** Play one turn of random moves, spawning now and then, as one candidate line of play. */
+void play_random_turn(hlt::Halite &game, hlt::TurnCommands &commands, std::mt19937 &rng) {
+    game.update_inspiration();
+    commands.clear(game.store.players.size());
+    for (const auto &[player_id, player] : game.store.players) {
+        for (const auto &entity_id : player.entities) {
+            commands.add(player_id.value, {entity_id.value, static_cast<hlt::AgentAction>(rng() % 5)});
+        }
+        if (player.energy >= game.config.NEW_ENTITY_ENERGY_COST && rng() % 4 == 0) {
+            commands.add(player_id.value, {player_id.value, hlt::AgentAction::Spawn});
+        }
+    }
+    game.process_turn(commands);
+    game.turn_number++;
+}
+
+/**
+ * Time repetitions of an operation, scaled so each measurement takes a good fraction of a second.
+ * @return The operations per second.
+ */
+template<class F>
+double per_second(F operation) {
+    operation();
+    long repetitions = 0;
+    const auto start = clock_type::now();
+    std::chrono::duration<double> elapsed{};
+    do {
+        for (int i = 0; i < 64; i++) {
+            operation();
+        }
+        repetitions += 64;
+        elapsed = clock_type::now() - start;
+    } while (elapsed.count() < 0.25);
+    return repetitions / elapsed.count();
+}
+
+/**
+ * Play lines of lookahead from a root snapshot on several threads, each with its own fork.
+ * @return The turns played per second over all threads.
+ */
+double lookahead_turns_per_second(const hlt::Halite &root, unsigned int threads) {
+    static constexpr int LINES_PER_THREAD = 400;
+    const auto snapshot = root.snapshot();
+    std::vector<std::unique_ptr<hlt::GameFork>> forks;
+    for (unsigned int thread = 0; thread < threads; thread++) {
+        forks.push_back(root.fork());
+    }
+
+    const auto start = clock_type::now();
+    std::vector<std::thread> workers;
+    for (unsigned int thread = 0; thread < threads; thread++) {
+        workers.emplace_back([&snapshot, &fork = *forks[thread], thread] {
+            std::mt19937 rng(thread);
+            hlt::TurnCommands commands;
+            for (int line = 0; line < LINES_PER_THREAD; line++) {
+                fork.game.restore(snapshot);
+                for (int turn = 0; turn < LOOKAHEAD_TURNS; turn++) {
+                    play_random_turn(fork.game, commands, rng);
+                }
+            }
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    const std::chrono::duration<double> elapsed = clock_type::now() - start;
+    return static_cast<double>(threads) * LINES_PER_THREAD * LOOKAHEAD_TURNS / elapsed.count();
+}
+
+}
+
+int main(int, char *[]) {
+    const auto threads = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << std::left << std::setw(8) << "size"
+              << std::setw(10) << "ships"
+              << std::setw(12) << "forks/s"
+              << std::setw(12) << "KiB/fork"
+              << std::setw(14) << "restores/s"
+              << "lookahead turns/s (" << threads << " threads)" << std::endl;
+    for (long size = 32; size <= 64; size += 16) {
+        BenchGame root(static_cast<unsigned int>(size), size);
+        hlt::TurnCommands commands;
+        std::mt19937 rng(static_cast<unsigned int>(size));
+        for (int turn = 0; turn < OPENING_TURNS; turn++) {
+            play_random_turn(*root.halite, commands, rng);
+        }
+
+        const auto before_fork = hlt::allocations_so_far();
+        auto fork = root.halite->fork();
+        const auto fork_bytes = (hlt::allocations_so_far() - before_fork).bytes;
+        const auto forks = per_second([&] { fork = root.halite->fork(); });
+
+        const auto snapshot = root.halite->snapshot();
+        const auto restores = per_second([&] { fork->game.restore(snapshot); });
+
+        const auto name = std::to_string(size) + "x" + std::to_string(size);
+        std::cout << std::fixed << std::setprecision(0)
+                  << std::setw(8) << name
+                  << std::setw(10) << root.halite->store.entities.size()
+                  << std::setw(12) << forks
+                  << std::setw(12) << std::setprecision(1) << fork_bytes / 1024.0
+                  << std::setw(14) << std::setprecision(0) << restores
+                  << lookahead_turns_per_second(*root.halite, threads) << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,159 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Cell.hpp"
+#include "Grid.hpp"
+
+/**
+ * Microbenchmark comparing the old vector-of-vectors grid layout with the flat row-major Grid,
+ * unpadded and padded, for full-map scans and inspiration-style neighborhood scans.
+ */
+
+namespace {
+
+using hlt::Cell;
+using hlt::dimension_type;
+
+/** The previous Grid storage, kept here only as a point of comparison. */
+struct NestedGrid {
+    dimension_type width;
+    dimension_type height;
+    std::vector<std::vector<Cell>> grid;
+
+    NestedGrid(dimension_type width, dimension_type height) : width(width), height(height) {
+        grid.resize(static_cast<size_t>(height));
+        for (auto &row : grid) {
+            row.resize(static_cast<size_t>(width));
+        }
+    }
+
+    Cell &at(dimension_type x, dimension_type y) { return grid[y][x]; }
+};
+
+/** Sink that keeps the compiler from discarding benchmark results. */
+volatile long sink;
+
+/**
+ * Fill a grid with random energy and a sprinkling of entities.
+ * @tparam G The grid type.
+ * @param grid The grid to fill.
+ * @param rng The random number generator.
+ */
+template<class G>
+void fill(G &grid, std::mt19937 &rng) {
+    for (dimension_type y = 0; y < grid.height; y++) {
+        for (dimension_type x = 0; x < grid.width; x++) {
+            auto &cell = grid.at(x, y);
+            cell.energy = static_cast<hlt::energy_type>(rng() % 1000);
+            if (rng() % 16 == 0) {
+                cell.entity = hlt::Entity::id_type(static_cast<id_value_type>(rng() % 200));
+            }
+        }
+    }
+}
+
+/** Sum energy and count entities over every cell through at(x, y). */
+template<class G>
+long scan_at(G &grid) {
+    long total = 0;
+    for (dimension_type y = 0; y < grid.height; y++) {
+        for (dimension_type x = 0; x < grid.width; x++) {
+            const auto &cell = grid.at(x, y);
+            total += cell.energy + (cell.entity != hlt::Entity::None);
+        }
+    }
+    return total;
+}
+
+/** Sum energy and count entities over every cell through row pointers. */
+long scan_rows(hlt::Grid<Cell> &grid) {
+    long total = 0;
+    for (dimension_type y = 0; y < grid.height; y++) {
+        for (const auto &cell : grid.row_span(y)) {
+            total += cell.energy + (cell.entity != hlt::Entity::None);
+        }
+    }
+    return total;
+}
+
+/** Count entities within Manhattan distance 4 of every cell, wrapping around the edges. */
+template<class G>
+long scan_neighborhoods(G &grid) {
+    static constexpr dimension_type RADIUS = 4;
+    long total = 0;
+    for (dimension_type y = 0; y < grid.height; y++) {
+        for (dimension_type x = 0; x < grid.width; x++) {
+            for (dimension_type dy = -RADIUS; dy <= RADIUS; dy++) {
+                const auto reach = RADIUS - std::abs(dy);
+                const auto cy = (y + dy + grid.height) % grid.height;
+                for (dimension_type dx = -reach; dx <= reach; dx++) {
+                    const auto cx = (x + dx + grid.width) % grid.width;
+                    total += grid.at(cx, cy).entity != hlt::Entity::None;
+                }
+            }
+        }
+    }
+    return total;
+}
+
+/**
+ * Time a scan, returning nanoseconds per cell visited.
+ * @param cells The number of cells visited by one scan.
+ * @param scan The scan to time.
+ */
+template<class F>
+double time_scan(dimension_type cells, F scan) {
+    using clock = std::chrono::steady_clock;
+    // Warm up, then scale the repetitions so each measurement takes a few milliseconds.
+    sink = scan();
+    const long repetitions = std::max(16L, 4000000L / cells);
+    const auto start = clock::now();
+    for (long i = 0; i < repetitions; i++) {
+        sink = sink + scan();
+    }
+    const std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+    return elapsed.count() / (static_cast<double>(repetitions) * cells);
+}
+
+}
+
+int main(int, char *[]) {
+    std::cout << std::left << std::setw(8) << "size"
+              << std::setw(14) << "layout"
+              << std::setw(14) << "at ns/cell"
+              << std::setw(14) << "row ns/cell"
+              << std::setw(18) << "radius-4 ns/cell" << std::endl;
+    for (dimension_type size = 32; size <= 64; size += 8) {
+        std::mt19937 rng(static_cast<unsigned int>(size));
+        NestedGrid nested(size, size);
+        fill(nested, rng);
+        rng.seed(static_cast<unsigned int>(size));
+        hlt::Grid<Cell> flat(size, size);
+        fill(flat, rng);
+        rng.seed(static_cast<unsigned int>(size));
+        hlt::Grid<Cell> padded(size, size, true);
+        fill(padded, rng);
+
+        const auto cells = size * size;
+        const auto name = std::to_string(size) + "x" + std::to_string(size);
+        std::cout << std::fixed << std::setprecision(3)
+                  << std::setw(8) << name << std::setw(14) << "nested"
+                  << std::setw(14) << time_scan(cells, [&] { return scan_at(nested); })
+                  << std::setw(14) << "-"
+                  << std::setw(18) << time_scan(cells, [&] { return scan_neighborhoods(nested); }) << std::endl;
+        std::cout << std::setw(8) << name << std::setw(14) << "flat"
+                  << std::setw(14) << time_scan(cells, [&] { return scan_at(flat); })
+                  << std::setw(14) << time_scan(cells, [&] { return scan_rows(flat); })
+                  << std::setw(18) << time_scan(cells, [&] { return scan_neighborhoods(flat); }) << std::endl;
+        std::cout << std::setw(8) << name << std::setw(14) << "flat-padded"
+                  << std::setw(14) << time_scan(cells, [&] { return scan_at(padded); })
+                  << std::setw(14) << time_scan(cells, [&] { return scan_rows(padded); })
+                  << std::setw(18) << time_scan(cells, [&] { return scan_neighborhoods(padded); }) << std::endl;
+    }
+    return 0;
+}
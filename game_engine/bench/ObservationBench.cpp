@@ -0,0 +1,242 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "../observation.hpp"
+#include "../rollout_buffer.hpp"
+#include "../vec_env.hpp"
+
+#include <torch/torch.h>
+
+/**
+ * Benchmark comparing the previous observation encoder, which builds twelve tensors per ship from a GameState and
+ * stacks them, with encodeSteps, which decodes a RolloutBuffer into shared and per-ship blocks of reusable buffers.
+ * Also compares the memory held by the previous per-ship states with that of the buffer.
+ */
+
+namespace {
+
+/** The previous per-ship state, kept here only as a point of comparison. */
+std::shared_ptr<EntityState> parseGameIntoEntityState(std::shared_ptr<GameState> &gameState, long playerId, int entityY, int entityX, float entityEnergy) {
+    auto entityStatePtr = std::make_shared<EntityState>();
+    auto entityState = entityStatePtr.get();
+
+    entityState->gameState = gameState;
+    entityState->entityY = entityY;
+    entityState->entityX = entityX;
+    entityState->halite_on_ship = (entityEnergy / MAX_HALITE_ON_SHIP) - 0.5;
+    entityState->playerId = playerId;
+
+    return entityStatePtr;
+}
+
+/** The previous per-turn state, kept here only as a point of comparison. */
+std::shared_ptr<GameState> parseGameIntoGameState(hlt::Halite &game) {
+    auto gameStatePtr = std::make_shared<GameState>();
+    auto gameState = gameStatePtr.get();
+    const int totalSteps = 401;
+
+    for(int y = 0; y < game.map.height; y++) {
+        const auto row = game.map.row(y);
+        for (int x = 0; x < game.map.width; x++) {
+            const auto &cell = row[x];
+            gameState->position[y][x].halite_on_ground = (cell.energy / MAX_HALITE_ON_MAP) - 0.5;
+            if(cell.entity.value != -1) {
+                auto entity = game.store.get_entity(cell.entity);
+                gameState->position[y][x].halite_on_ship = (entity.energy / MAX_HALITE_ON_SHIP) - 0.5;
+                gameState->position[y][x].shipOwnerId = entity.owner.value;
+            }
+        }
+    }
+
+    for(auto playerPair : game.store.players) {
+        auto player = playerPair.second;
+        auto spawn = player.factory;
+        gameState->position[spawn.y][spawn.x].dropOffPresent = true;
+        gameState->position[spawn.y][spawn.x].spawnPresent = true;
+        gameState->position[spawn.y][spawn.x].structureOwnerId = player.id.value;
+        for(auto dropoff : player.dropoffs) {
+            gameState->position[dropoff.location.y][dropoff.location.x].dropOffPresent = true;
+            gameState->position[dropoff.location.y][dropoff.location.x].structureOwnerId = player.id.value;
+        }
+        gameState->scores[player.id.value] = ((float)player.energy / MAX_SCORE_APPROXIMATE) - 0.5;
+    }
+
+    float steps_remaining_value = totalSteps - game.turn_number + 1;
+    gameState->steps_remaining = (steps_remaining_value / float(totalSteps)) - 0.5;
+    return gameStatePtr;
+}
+
+/** The previous per-ship encoder, kept here only as a point of comparison. */
+torch::Tensor convertEntityStateToTensor(std::shared_ptr<EntityState> &entityStatePtr) {
+
+    auto entityState = entityStatePtr.get();
+    auto gameState = entityState->gameState.get();
+    auto playerId = entityState->playerId;
+
+    //Global info
+    auto steps_remaining = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
+    //My global info
+    auto my_ships = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
+    auto my_ships_halite = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
+    auto my_dropoffs = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
+    auto my_score = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
+    //Enemy global info
+    auto enemy_ships = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
+    auto enemy_ships_halite = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
+    auto enemy_dropoffs = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
+    auto enemy_score = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
+
+    //Ship specific information
+    auto entity_location = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
+    auto entity_energy = torch::zeros({GAME_HEIGHT, GAME_WIDTH});
+
+    entity_location[entityState->entityY][entityState->entityX] = 1;
+    entity_energy[entityState->entityY][entityState->entityX] = entityState->halite_on_ship;
+
+    steps_remaining.fill_(gameState->steps_remaining);
+
+    //TODO: Generalize for more players
+    if(playerId == 0) {
+        my_score.fill_(gameState->scores[0]);
+        enemy_score.fill_(gameState->scores[1]);
+    } else {
+        my_score.fill_(gameState->scores[1]);
+        enemy_score.fill_(gameState->scores[0]);
+    }
+
+    float halite = -1.0;
+    float haliteLocationArray[GAME_HEIGHT][GAME_WIDTH];
+
+    for(std::size_t y = 0; y < GAME_HEIGHT; y++) {
+        for(std::size_t x = 0; x < GAME_WIDTH; x++) {
+            auto cell = gameState->position[y][x];
+            haliteLocationArray[y][x] = cell.halite_on_ground;
+
+            if(cell.shipOwnerId == playerId) {
+                my_ships[y][x] = 1;
+                my_ships_halite[y][x] = cell.halite_on_ship;
+            }
+            else if (cell.shipOwnerId != -1) {
+                enemy_ships[y][x] = 1;
+                enemy_ships_halite[y][x] = cell.halite_on_ship;
+                halite = cell.halite_on_ship;
+            }
+
+            if(cell.structureOwnerId == playerId) {
+                my_dropoffs[y][x] = 1;
+            }
+            else if (cell.structureOwnerId != -1) {
+                enemy_dropoffs[y][x] = 1;
+            }
+        }
+    }
+
+    auto halite_location = torch::from_blob(haliteLocationArray, {GAME_HEIGHT, GAME_WIDTH});
+    std::vector<torch::Tensor> frames {halite_location, steps_remaining,
+    my_ships, my_ships_halite, my_dropoffs, my_score,
+    enemy_ships, enemy_ships_halite, enemy_dropoffs, enemy_score,
+    entity_location, entity_energy};
+
+    auto stateTensor = torch::stack(frames);
+    return stateTensor;
+}
+
+/** Sink that keeps the compiler from discarding benchmark results. */
+volatile double sink;
+
+/**
+ * Time an encoder, returning ships encoded per second.
+ * @param ships The number of ships encoded by one call.
+ * @param encode The encoder to time.
+ */
+template<class F>
+double time_encoder(std::size_t ships, F encode) {
+    using clock = std::chrono::steady_clock;
+    // Warm up, then scale the repetitions so each measurement takes a fraction of a second.
+    sink = encode();
+    const long repetitions = std::max(4L, static_cast<long>(20000 / ships));
+    const auto start = clock::now();
+    for (long i = 0; i < repetitions; i++) {
+        sink = sink + encode();
+    }
+    const std::chrono::duration<double> elapsed = clock::now() - start;
+    return static_cast<double>(repetitions * ships) / elapsed.count();
+}
+
+}
+
+int main(int, char *[]) {
+    // Play some games with random moves, so the ships and the map look like the middle of a real game.
+    const std::size_t num_games = 8;
+    VecHaliteEnv env(num_games, GAME_WIDTH, GAME_HEIGHT, NUMBER_OF_PLAYERS, hlt::SeedStream(1));
+    std::mt19937 rng(1);
+    for (int turn = 0; turn < 150; turn++) {
+        std::vector<long> actions(env.ships().size());
+        for (auto &action : actions) {
+            action = static_cast<long>(rng() % 5);
+        }
+        env.step(actions);
+    }
+
+    std::vector<std::shared_ptr<GameState>> gameStates;
+    RolloutBuffer rollouts;
+    for (std::size_t i = 0; i < num_games; i++) {
+        gameStates.push_back(parseGameIntoGameState(env.game(i)));
+        rollouts.add_turn(env.game(i));
+    }
+    std::vector<std::shared_ptr<EntityState>> entityStates;
+    std::vector<std::size_t> steps;
+    for (const auto &ship : env.ships()) {
+        entityStates.push_back(parseGameIntoEntityState(gameStates[ship.game], ship.player_id,
+                                                        ship.location.y, ship.location.x, ship.energy));
+        steps.push_back(rollouts.add_step(ship.game, static_cast<uint32_t>(ship.game), ship.entity, ship.player_id,
+                                          ship.location, ship.energy));
+    }
+    const auto ships = entityStates.size();
+    if (ships == 0) {
+        std::cout << "No ships to encode" << std::endl;
+        return 1;
+    }
+
+    SplitObservationBuffers splitBuffers;
+    auto stacked = [&] {
+        std::vector<torch::Tensor> stateList;
+        for (auto &entityState : entityStates) {
+            stateList.push_back(convertEntityStateToTensor(entityState));
+        }
+        return torch::stack(stateList).sum().item<double>();
+    };
+    auto split = [&] {
+        auto observations = encodeSteps(rollouts, steps, splitBuffers);
+        return observations.shared.sum().item<double>() + observations.ship.sum().item<double>();
+    };
+
+    std::vector<torch::Tensor> stateList;
+    for (auto &entityState : entityStates) {
+        stateList.push_back(convertEntityStateToTensor(entityState));
+    }
+    const auto expected = torch::stack(stateList);
+    const auto observations = encodeSteps(rollouts, steps, splitBuffers);
+    const auto rebuilt = torch::cat({observations.shared.index_select(0, observations.sharedIndex), observations.ship}, 1);
+    const bool same = torch::equal(expected, rebuilt);
+
+    // Each previous rollout was a 64-byte RolloutItem pointing at an EntityState, which pointed at its turn's GameState;
+    // both were allocated by make_shared along with a control block of about two pointers.
+    const std::size_t rolloutItem = 64;
+    const auto controlBlock = 2 * sizeof(void *);
+    const auto previousBytes = num_games * (sizeof(GameState) + controlBlock)
+                               + ships * (rolloutItem + sizeof(EntityState) + controlBlock);
+
+    std::cout << ships << " ships in " << num_games << " games, " << observations.shared.size(0)
+              << " shared blocks, encodings " << (same ? "match" : "DIFFER") << std::endl;
+    std::cout << "memory: previous " << previousBytes << " bytes, buffer " << rollouts.memory_bytes() << " bytes" << std::endl;
+    std::cout << std::left << std::setw(14) << "encoder" << "ships/s" << std::endl;
+    std::cout << std::fixed << std::setprecision(0)
+              << std::setw(14) << "stack" << time_encoder(ships, stacked) << std::endl;
+    std::cout << std::setw(14) << "split" << time_encoder(ships, split) << std::endl;
+    return same ? 0 : 1;
+}
@@ -0,0 +1,89 @@
+#include <random>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "../../model.hpp"
+#include "../observation.hpp"
+#include "../rollout_buffer.hpp"
+#include "../vec_env.hpp"
+
+#include <torch/torch.h>
+
+/**
+ * Benchmarks of the training side for halite_bench, built only with libtorch: encoding the observations of a turn
+ * and a forward pass of the network at several batch sizes.
+ */
+
+namespace {
+
+/** Ships from the middle of games played with random moves, stored as the rollout workers store a turn. */
+struct BenchTurn {
+    RolloutBuffer rollouts;
+    std::vector<std::size_t> steps;
+
+    /**
+     * Play the games and store their last turn.
+     * @param games The number of games.
+     */
+    explicit BenchTurn(std::size_t games) {
+        VecHaliteEnv env(games, GAME_WIDTH, GAME_HEIGHT, NUMBER_OF_PLAYERS, hlt::SeedStream(1));
+        std::mt19937 rng(1);
+        for (int turn = 0; turn < 150; turn++) {
+            std::vector<long> actions(env.ships().size());
+            for (auto &action : actions) {
+                action = static_cast<long>(rng() % 5);
+            }
+            env.step(actions);
+        }
+        for (std::size_t game = 0; game < games; game++) {
+            rollouts.add_turn(env.game(game));
+        }
+        for (const auto &ship : env.ships()) {
+            steps.push_back(rollouts.add_step(ship.game, static_cast<uint32_t>(ship.game), ship.entity, ship.player_id,
+                                              ship.location, ship.energy));
+        }
+    }
+};
+
+/**
+ * Encode every ship of a turn with encodeSteps, the encoder of the rollout workers and of training.
+ * @param state The argument is the number of games in the turn. Items are ships.
+ */
+void encode_steps(bench::State &state) {
+    BenchTurn turn(static_cast<std::size_t>(state.range(0)));
+    SplitObservationBuffers buffers;
+    for (auto _ : state) {
+        auto observations = encodeSteps(turn.rollouts, turn.steps, buffers);
+        bench::do_not_optimize(observations.ship.data_ptr());
+    }
+    state.set_items_processed(state.max_iterations() * turn.steps.size());
+}
+HALITE_BENCHMARK(encode_steps)->arg(1)->arg(8);
+
+/**
+ * Sample actions for a batch of ships with a forward pass of the network, without gradients.
+ * @param state The argument is the batch size. Items are ships.
+ */
+void forward(bench::State &state) {
+    torch::manual_seed(1);
+    const auto batch = static_cast<std::size_t>(state.range(0));
+    BenchTurn turn(8);
+    std::vector<std::size_t> steps;
+    for (std::size_t i = 0; i < batch; i++) {
+        steps.push_back(turn.steps[i % turn.steps.size()]);
+    }
+    SplitObservationBuffers buffers;
+    const auto observations = encodeSteps(turn.rollouts, steps, buffers);
+
+    ActorCriticNetwork network(false);
+    torch::NoGradGuard noGrad;
+    torch::Tensor emptyAction;
+    for (auto _ : state) {
+        auto output = network.forward(observations.shared, observations.sharedIndex, observations.ship, emptyAction);
+        bench::do_not_optimize(output.value.cpu().data_ptr());
+    }
+    state.set_items_processed(state.max_iterations() * batch);
+}
+HALITE_BENCHMARK(forward)->arg(1)->arg(32)->arg(256);
+
+}
@@ -0,0 +1,256 @@
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include "ScriptedBot.hpp"
+
+namespace hlt {
+
+namespace {
+
+/** The moves a ship can make, with the actions that make them. */
+constexpr std::array<std::pair<Direction, AgentAction>, 4> MOVES{{
+        {Direction::North, AgentAction::North},
+        {Direction::East, AgentAction::East},
+        {Direction::South, AgentAction::South},
+        {Direction::West, AgentAction::West},
+}};
+
+/**
+ * Get the action of a move.
+ * @param direction The direction of the move.
+ * @return The action.
+ */
+AgentAction action_of(Direction direction) {
+    for (const auto &[move, action] : MOVES) {
+        if (move == direction) {
+            return action;
+        }
+    }
+    return AgentAction::Still;
+}
+
+/**
+ * Get the offset from one coordinate to another along the shorter way around a wrapping axis.
+ * @param from The first coordinate.
+ * @param to The second coordinate.
+ * @param size The length of the axis.
+ * @return The signed offset, at most half the axis in size.
+ */
+dimension_type wrapped_offset(dimension_type from, dimension_type to, dimension_type size) {
+    auto offset = (to - from + size) % size;
+    return offset > size / 2 ? offset - size : offset;
+}
+
+}
+
+/**
+ * Parse the name of a scripted policy: random, greedy-miner or return-when-full.
+ * @param name The name.
+ * @param[out] kind The policy.
+ * @return True if the name is known.
+ */
+bool parse_bot_kind(const std::string &name, BotKind &kind) {
+    for (const auto candidate : {BotKind::Random, BotKind::GreedyMiner, BotKind::ReturnWhenFull}) {
+        if (name == bot_name(candidate)) {
+            kind = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Get the name of a scripted policy, as parse_bot_kind accepts it.
+ * @param kind The policy.
+ * @return The name.
+ */
+const char *bot_name(BotKind kind) {
+    switch (kind) {
+    case BotKind::Random:
+        return "random";
+    case BotKind::GreedyMiner:
+        return "greedy-miner";
+    case BotKind::ReturnWhenFull:
+        return "return-when-full";
+    }
+    return "unknown";
+}
+
+/**
+ * Create a ScriptedBot.
+ * @param kind The policy.
+ * @param seed The seed of the policy's random number generator.
+ */
+ScriptedBot::ScriptedBot(BotKind kind, unsigned int seed) : _kind(kind), rng(seed) {}
+
+/**
+ * Get whether a move leads to an unclaimed cell.
+ * @param map The game map.
+ * @param location The location of the ship.
+ * @param direction The direction of the move.
+ * @return True if no other ship of the bot ends the turn there.
+ */
+bool ScriptedBot::open(const Map &map, Location location, Direction direction) const {
+    map.move_location(location, direction);
+    return !claimed[map.index(location.x, location.y)];
+}
+
+/**
+ * Choose the action of a ship that can pay for a move.
+ * @param game The game.
+ * @param player The player owning the ship.
+ * @param ship The ship.
+ * @return The action.
+ */
+AgentAction ScriptedBot::choose(const Halite &game, const Player &player, const Entity &ship) {
+    const auto &map = game.map;
+    const auto location = ship.location;
+
+    if (_kind == BotKind::Random) {
+        const auto choice = rng() % (MOVES.size() + 1);
+        if (choice < MOVES.size() && open(map, location, MOVES[choice].first)) {
+            return MOVES[choice].second;
+        }
+        return AgentAction::Still;
+    }
+
+    if (std::binary_search(returning.begin(), returning.end(), ship.id)) {
+        // Head for the nearest structure, along the longer axis of the way there first.
+        auto home = player.factory;
+        for (const auto &dropoff : player.dropoffs) {
+            if (map.distance(location, dropoff.location) < map.distance(location, home)) {
+                home = dropoff.location;
+            }
+        }
+        const auto dx = wrapped_offset(location.x, home.x, map.width);
+        const auto dy = wrapped_offset(location.y, home.y, map.height);
+        const auto horizontal = dx > 0 ? Direction::East : Direction::West;
+        const auto vertical = dy > 0 ? Direction::South : Direction::North;
+        std::array<std::pair<dimension_type, Direction>, 2> ways{{{std::abs(dx), horizontal},
+                                                                  {std::abs(dy), vertical}}};
+        if (ways[1].first > ways[0].first) {
+            std::swap(ways[0], ways[1]);
+        }
+        for (const auto &[distance, direction] : ways) {
+            if (distance > 0 && open(map, location, direction)) {
+                return action_of(direction);
+            }
+        }
+        return AgentAction::Still;
+    }
+
+    // Keep mining a cell until it runs low.
+    if (map.at(location).energy >= game.config.MAX_ENERGY / 10) {
+        return AgentAction::Still;
+    }
+
+    if (_kind == BotKind::GreedyMiner) {
+        auto best = AgentAction::Still;
+        energy_type best_energy = -1;
+        for (const auto &[direction, action] : MOVES) {
+            auto neighbor = location;
+            map.move_location(neighbor, direction);
+            const auto energy = map.at(neighbor).energy;
+            if (energy > best_energy && open(map, location, direction)) {
+                best = action;
+                best_energy = energy;
+            }
+        }
+        return best;
+    }
+
+    const auto first = rng() % MOVES.size();
+    for (std::size_t offset = 0; offset < MOVES.size(); offset++) {
+        const auto &[direction, action] = MOVES[(first + offset) % MOVES.size()];
+        if (open(map, location, direction)) {
+            return action;
+        }
+    }
+    return AgentAction::Still;
+}
+
+/**
+ * Add the commands of one player for the coming turn.
+ * @param game The game, with inspiration already updated for the turn.
+ * @param player The player the bot plays as.
+ * @param[out] commands The commands of the turn, already cleared.
+ */
+void ScriptedBot::play(const Halite &game, const Player &player, TurnCommands &commands) {
+    const auto &map = game.map;
+    const auto &config = game.config;
+    claimed.assign(map.grid.size(), 0);
+
+    // Ships start returning when nearly full, and keep returning until they have dropped off.
+    still_returning.clear();
+    for (const auto &entity_id : player.entities) {
+        const auto energy = game.store.get_entity(entity_id).energy;
+        const bool was_returning = std::binary_search(returning.begin(), returning.end(), entity_id);
+        if (_kind != BotKind::Random && (was_returning ? energy > 0 : energy >= config.MAX_ENERGY * 9 / 10)) {
+            still_returning.push_back(entity_id);
+        }
+    }
+    returning.swap(still_returning);
+
+    // Ships that cannot pay for a move stay where they are, so they claim their cells first.
+    const auto can_move = [&config, &map](const Entity &ship) {
+        const auto ratio = ship.is_inspired ? config.INSPIRED_MOVE_COST_RATIO : config.MOVE_COST_RATIO;
+        return ship.energy >= map.at(ship.location).energy / static_cast<energy_type>(ratio);
+    };
+    for (const auto &entity_id : player.entities) {
+        const auto &ship = game.store.get_entity(entity_id);
+        if (!can_move(ship)) {
+            claimed[map.index(ship.location.x, ship.location.y)] = 1;
+        }
+    }
+
+    for (const auto &entity_id : player.entities) {
+        const auto &ship = game.store.get_entity(entity_id);
+        auto action = AgentAction::Still;
+        if (can_move(ship)) {
+            action = choose(game, player, ship);
+            // Make way for a ship that already claimed this cell.
+            if (action == AgentAction::Still && claimed[map.index(ship.location.x, ship.location.y)]) {
+                for (const auto &[direction, move] : MOVES) {
+                    if (open(map, ship.location, direction)) {
+                        action = move;
+                        break;
+                    }
+                }
+            }
+        }
+        auto destination = ship.location;
+        for (const auto &[direction, move] : MOVES) {
+            if (move == action) {
+                map.move_location(destination, direction);
+            }
+        }
+        claimed[map.index(destination.x, destination.y)] = 1;
+        commands.add(player.id.value, {entity_id.value, action});
+    }
+
+    const bool wants_ship = _kind == BotKind::Random ? rng() % 4 == 0 : game.turn_number <= config.MAX_TURNS / 2;
+    if (wants_ship && player.energy >= config.NEW_ENTITY_ENERGY_COST
+        && !claimed[map.index(player.factory.x, player.factory.y)]) {
+        commands.add(player.id.value, {player.id.value, AgentAction::Spawn});
+    }
+}
+
+void play_game(Halite &game, std::vector<ScriptedBot> &bots, TurnCommands &commands) {
+    const auto players = game.store.players.size();
+    while (true) {
+        game.update_inspiration();
+        commands.clear(players);
+        for (const auto &[player_id, player] : game.store.players) {
+            bots[player_id.value].play(game, player, commands);
+        }
+        game.process_turn(commands);
+        game.turn_number++;
+        // The limit is the one initialize_game scaled to the map, not the global default.
+        if (game.game_ended() || game.turn_number >= game.config.MAX_TURNS) {
+            break;
+        }
+    }
+}
+
+}
@@ -0,0 +1,98 @@
+#ifndef SCRIPTEDBOT_HPP
+#define SCRIPTEDBOT_HPP
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Halite.hpp"
+#include "TurnCommands.hpp"
+
+namespace hlt {
+
+/** The built-in scripted policies. */
+enum class BotKind {
+    Random,          /**< Moves at random and spawns now and then. */
+    GreedyMiner,     /**< Mines the richest cell next to it, and returns home when full. */
+    ReturnWhenFull,  /**< Mines until its cell runs low, wanders at random, and returns home when full. */
+};
+
+/**
+ * Parse the name of a scripted policy: random, greedy-miner or return-when-full.
+ * @param name The name.
+ * @param[out] kind The policy.
+ * @return True if the name is known.
+ */
+bool parse_bot_kind(const std::string &name, BotKind &kind);
+
+/**
+ * Get the name of a scripted policy, as parse_bot_kind accepts it.
+ * @param kind The policy.
+ * @return The name.
+ */
+const char *bot_name(BotKind kind);
+
+/**
+ * A player driven by a fixed script instead of a model, as a baseline for engine throughput and for scores.
+ *
+ * Every command it gives is legal: ships only try moves they can pay for, and it only spawns when the player can
+ * afford a ship. Each ship claims the cell it will end the turn on, and later ships keep off claimed cells, so the
+ * bot rarely collides with itself.
+ */
+class ScriptedBot {
+    BotKind _kind;                                /**< The policy. */
+    std::mt19937 rng;                             /**< The random number generator of the policy. */
+    std::vector<uint8_t> claimed;                 /**< Whether one of the bot's ships ends the turn on each cell. */
+    std::vector<Entity::id_type> returning;       /**< The ships heading home to drop off, in ID order. */
+    std::vector<Entity::id_type> still_returning; /**< Scratch list of the returning ships for the next turn. */
+
+    /**
+     * Choose the action of a ship that can pay for a move.
+     * @param game The game.
+     * @param player The player owning the ship.
+     * @param ship The ship.
+     * @return The action.
+     */
+    AgentAction choose(const Halite &game, const Player &player, const Entity &ship);
+
+    /**
+     * Get whether a move leads to an unclaimed cell.
+     * @param map The game map.
+     * @param location The location of the ship.
+     * @param direction The direction of the move.
+     * @return True if no other ship of the bot ends the turn there.
+     */
+    bool open(const Map &map, Location location, Direction direction) const;
+
+public:
+    /**
+     * Create a ScriptedBot.
+     * @param kind The policy.
+     * @param seed The seed of the policy's random number generator.
+     */
+    ScriptedBot(BotKind kind, unsigned int seed);
+
+    /** Get the policy. */
+    BotKind kind() const { return _kind; }
+
+    /**
+     * Add the commands of one player for the coming turn.
+     * @param game The game, with inspiration already updated for the turn.
+     * @param player The player the bot plays as.
+     * @param[out] commands The commands of the turn, already cleared.
+     */
+    void play(const Halite &game, const Player &player, TurnCommands &commands);
+};
+
+/**
+ * Play a game between scripted bots until it ends or reaches the game's own turn limit.
+ * @param game The game, already initialized.
+ * @param bots The bot of each player, by player ID.
+ * @param commands Scratch commands, reused across turns.
+ */
+void play_game(Halite &game, std::vector<ScriptedBot> &bots, TurnCommands &commands);
+
+}
+
+#endif // SCRIPTEDBOT_HPP
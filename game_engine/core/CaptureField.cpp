@@ -0,0 +1,89 @@
+#include <algorithm>
+
+#include "CaptureField.hpp"
+
+namespace hlt {
+
+/**
+ * Count the ships within a radius of every cell.
+ * @param store The entity store.
+ * @param map The game map.
+ * @param radius The capture radius.
+ */
+void CaptureField::compute(const Store &store, const Map &map, dimension_type radius) {
+    width = map.width;
+    height = map.height;
+    players = 0;
+    for (const auto &[player_id, _] : store.players) {
+        players = std::max(players, static_cast<std::size_t>(player_id.value) + 1);
+    }
+    const auto cells = static_cast<std::size_t>(width * height);
+
+    // The diamond holds the cells at wrapped distance at most radius. Row offsets that wrap onto the same row
+    // on small maps form a single slice, so no cell is counted twice.
+    slices.clear();
+    for (dimension_type row = 0; row < height; row++) {
+        const auto row_distance = std::min(row, height - row);
+        if (row_distance <= radius) {
+            slices.push_back(Slice{row, radius - row_distance});
+        }
+    }
+
+    occupancy.assign(players * cells, 0);
+    counts.assign(players * cells, 0);
+    for (const auto &entity : store.entities) {
+        occupancy[static_cast<std::size_t>(entity.owner.value) * cells
+                  + static_cast<std::size_t>(entity.location.y * width + entity.location.x)]++;
+    }
+
+    prefix.resize(static_cast<std::size_t>(3 * width + 1));
+    for (std::size_t player = 0; player < players; player++) {
+        const auto *player_occupancy = occupancy.data() + player * cells;
+        auto *player_counts = counts.data() + player * cells;
+        for (dimension_type source = 0; source < height; source++) {
+            const auto *row = player_occupancy + source * width;
+            uint32_t total = 0;
+            for (dimension_type x = 0; x < width; x++) {
+                total += row[x];
+            }
+            if (total == 0) {
+                continue;
+            }
+
+            // prefix[i] is the number of ships in the first i columns of the row repeated three times, so a
+            // window around any column can be read without wrapping. The two copies are the first plus one or two
+            // whole rows.
+            prefix[0] = 0;
+            for (dimension_type x = 0; x < width; x++) {
+                prefix[x + 1] = prefix[x] + row[x];
+            }
+            for (dimension_type x = 1; x <= width; x++) {
+                prefix[width + x] = prefix[x] + total;
+                prefix[2 * width + x] = prefix[x] + 2 * total;
+            }
+
+            for (const auto &slice : slices) {
+                auto target = source + slice.row;
+                if (target >= height) {
+                    target -= height;
+                }
+                auto *target_counts = player_counts + target * width;
+                const auto k = slice.half_width;
+                if (2 * k + 1 >= width) {
+                    // The slice covers the whole row.
+                    for (dimension_type x = 0; x < width; x++) {
+                        target_counts[x] += total;
+                    }
+                } else {
+                    const auto *upper = prefix.data() + width + k + 1;
+                    const auto *lower = prefix.data() + width - k;
+                    for (dimension_type x = 0; x < width; x++) {
+                        target_counts[x] += upper[x] - lower[x];
+                    }
+                }
+            }
+        }
+    }
+}
+
+}
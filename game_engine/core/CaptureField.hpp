@@ -0,0 +1,58 @@
+#ifndef CAPTUREFIELD_HPP
+#define CAPTUREFIELD_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "Map.hpp"
+#include "Store.hpp"
+
+namespace hlt {
+
+/**
+ * Per-player counts of the ships within capture range of every cell, recomputed once per turn.
+ *
+ * Each player's ships are laid out in an occupancy grid. Every row of that grid is turned into a prefix sum, from
+ * which the sums over the horizontal slices of the diamond are read off in one pass along the row and added to the
+ * rows the diamond spans. The number of ships near any cell is then a single lookup.
+ */
+class CaptureField {
+    /** A row offset of the diamond, with the half-width of its horizontal slice. */
+    struct Slice {
+        dimension_type row;         /**< The row offset, wrapped into [0, height). */
+        dimension_type half_width;  /**< The number of columns on either side of the center. */
+    };
+
+    dimension_type width{};         /**< The width of the map. */
+    dimension_type height{};        /**< The height of the map. */
+    std::size_t players{};          /**< The number of player slots. */
+    std::vector<Slice> slices;      /**< The slices of the diamond, one per distinct row. */
+    std::vector<uint16_t> occupancy; /**< The ships of each player at each cell, player-major. */
+    std::vector<uint16_t> counts;   /**< The ships of each player within range of each cell, player-major. */
+    std::vector<uint32_t> prefix;   /**< Scratch prefix sums over a row repeated three times. */
+
+public:
+    /**
+     * Count the ships within a radius of every cell.
+     * @param store The entity store.
+     * @param map The game map.
+     * @param radius The capture radius.
+     */
+    void compute(const Store &store, const Map &map, dimension_type radius);
+
+    /**
+     * Get the number of a player's ships near a location, each counted once even where the range wraps around.
+     * @param player The player.
+     * @param location The location.
+     * @return The number of the player's ships within the radius.
+     */
+    unsigned long count(const Player::id_type &player, const Location &location) const {
+        const auto cells = static_cast<std::size_t>(width * height);
+        return counts[static_cast<std::size_t>(player.value) * cells
+                      + static_cast<std::size_t>(location.y * width + location.x)];
+    }
+};
+
+}
+
+#endif // CAPTUREFIELD_HPP
@@ -0,0 +1,14 @@
+#include "GameFork.hpp"
+
+namespace hlt {
+
+/**
+ * Fork a game.
+ * @param parent The game to copy.
+ */
+GameFork::GameFork(const Halite &parent) :
+        map(parent.map),
+        statistics(parent.game_statistics),
+        game(map, statistics, parent) {}
+
+}
@@ -0,0 +1,35 @@
+#ifndef GAMEFORK_HPP
+#define GAMEFORK_HPP
+
+#include "Halite.hpp"
+#include "Statistics.hpp"
+
+namespace hlt {
+
+/**
+ * A copy of a game, owning its own map and statistics, that is played out apart from the game it was forked from.
+ *
+ * A fork shares no mutable state with its parent, so forks of one game can be played out on separate threads while
+ * the parent is left untouched. To try many lines of play from the same position, keep one fork per thread and
+ * restore it from a snapshot of the parent before each line, which copies the flat state into buffers the fork
+ * already owns instead of building a new game.
+ */
+class GameFork final {
+public:
+    Map map;                    /**< The fork's copy of the map. */
+    GameStatistics statistics;  /**< The fork's copy of the statistics. */
+    Halite game;                /**< The forked game, playing on the map and statistics above. */
+
+    /**
+     * Fork a game.
+     * @param parent The game to copy.
+     */
+    explicit GameFork(const Halite &parent);
+
+    GameFork(const GameFork &) = delete;
+    GameFork &operator=(const GameFork &) = delete;
+};
+
+}
+
+#endif // GAMEFORK_HPP
@@ -0,0 +1,77 @@
+#ifndef GAMESNAPSHOT_HPP
+#define GAMESNAPSHOT_HPP
+
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "Cell.hpp"
+
+namespace hlt {
+
+/**
+ * The state of a game between turns, as flat arrays of plain records.
+ *
+ * A snapshot holds everything that processing a turn reads or changes: the cells, the ships, the players' energy
+ * and structures, the ID counters and the random number generator. Taking one copies the arrays into buffers the
+ * snapshot keeps, so a snapshot that is reused never allocates once its buffers have grown, and restoring it copies
+ * them back. The game statistics and the replay are outside the game state, and are not saved.
+ */
+struct GameSnapshot {
+    /** A ship. */
+    struct EntityState {
+        id_value_type id;      /**< The entity ID. */
+        id_value_type owner;   /**< The owner ID. */
+        energy_type energy;    /**< The energy carried. */
+        Location location;     /**< The location on the map. */
+        bool was_captured;     /**< Whether the ship was captured. */
+        bool is_inspired;      /**< Whether the ship is inspired. */
+    };
+
+    /** A player. Its name and factory never change, and are not saved. */
+    struct PlayerState {
+        id_value_type id;                          /**< The player ID. */
+        energy_type energy;                        /**< The energy stockpiled. */
+        energy_type factory_energy_deposited;      /**< The energy deposited at the factory so far. */
+        energy_type total_energy_deposited;        /**< The energy collected so far. */
+        std::size_t dropoffs;                      /**< The number of dropoffs, saved after those of earlier players. */
+        bool terminated;                           /**< Whether the player was kicked out of the game. */
+        bool can_play;                             /**< Whether the player has sufficient resources remaining. */
+    };
+
+    /** A dropoff. */
+    struct DropoffState {
+        id_value_type id;                 /**< The dropoff ID. */
+        Location location;                /**< The location of the dropoff. */
+        energy_type deposited_halite;     /**< The energy deposited here so far. */
+    };
+
+    /** The energy a ship dropped off on the last turn. */
+    struct DroppedOff {
+        id_value_type entity;   /**< The entity ID. */
+        float energy;           /**< The energy dropped off. */
+    };
+
+    unsigned long turn_number{};             /**< The turn number. */
+    unsigned long long map_total_energy{};   /**< The total energy remaining on the map. */
+    id_value_type last_player_id{};          /**< The last player ID handed out. */
+    id_value_type last_entity_id{};          /**< The last entity ID handed out. */
+    id_value_type last_dropoff_id{};         /**< The last dropoff ID handed out. */
+    std::mt19937 rng;                        /**< The random number generator used for tie breaking. */
+
+    std::vector<Cell> cells;                 /**< The map storage, including any row padding. */
+    std::vector<EntityState> entities;       /**< The ships, in ID order. */
+    std::vector<PlayerState> players;        /**< The players, in ID order. */
+    std::vector<DropoffState> dropoffs;      /**< The dropoffs of all players, in player order. */
+    std::vector<id_value_type> self_collided; /**< The ships that collided with their own ships on the last turn. */
+    std::vector<DroppedOff> dropped_off;     /**< The energy dropped off on the last turn. */
+};
+
+static_assert(std::is_trivially_copyable_v<Cell>, "cells are saved by copying the map storage");
+static_assert(std::is_trivially_copyable_v<GameSnapshot::EntityState>, "snapshot records are plain data");
+static_assert(std::is_trivially_copyable_v<GameSnapshot::PlayerState>, "snapshot records are plain data");
+static_assert(std::is_trivially_copyable_v<GameSnapshot::DropoffState>, "snapshot records are plain data");
+
+}
+
+#endif // GAMESNAPSHOT_HPP
@@ -1,6 +1,9 @@
+#include <algorithm>
+#include <cassert>
 #include <future>
 #include <sstream>
 
+#include "GameFork.hpp"
 #include "Halite.hpp"
 #include "HaliteImpl.hpp"
 
@@ -14,16 +17,36 @@ namespace hlt {
  * @param players The list of players.
  * @param game_statistics The game statistics to use.
  * @param replay The game replay to use.
+ * @param config The settings of this game.
  */
 Halite::Halite(Map &map,
                GameStatistics &game_statistics,
-               Replay &replay) :
-        map(map),
+               Replay &replay,
+               const GameConfig &config) :
         game_statistics(game_statistics),
+        config(config),
         //replay(replay),
+        map(map),
         impl(std::make_unique<HaliteImpl>(*this)),
         rng(replay.map_generator_seed) {}
 
+/**
+ * Constructor for a fork, continuing from the state of another game.
+ *
+ * @param map The copy of the parent's map.
+ * @param game_statistics The copy of the parent's statistics.
+ * @param parent The game to continue from.
+ */
+Halite::Halite(Map &map, GameStatistics &game_statistics, const Halite &parent) :
+        occupancy(parent.occupancy),
+        game_statistics(game_statistics),
+        turn_number(parent.turn_number),
+        config(parent.config),
+        store(parent.store),
+        map(map),
+        impl(std::make_unique<HaliteImpl>(*this)),
+        rng(parent.rng) {}
+
 /**
  * Run the game.
  * @param player_commands The list of player commands.
@@ -41,11 +64,22 @@ void Halite::update_inspiration() {
     impl->update_inspiration(); 
 }
 
-/** Retrieve and process commands, and update the game state for the current turn. */
-void Halite::process_turn(std::map<long, std::vector<AgentCommand>> rawCommands){
+/**
+ * Parse string commands, then process them as typed commands.
+ * @param rawCommands The commands of each player, by player ID.
+ */
+void Halite::process_turn(const std::map<long, std::vector<AgentCommand>> &rawCommands){
     impl->process_turn(rawCommands);
 }
 
+/**
+ * Process typed commands, and update the game state for the current turn.
+ * @param commands The commands of each player.
+ */
+void Halite::process_turn(const TurnCommands &commands){
+    impl->process_turn(commands);
+}
+
 bool Halite::game_ended() {
     return impl->game_ended();
 }
@@ -58,6 +92,49 @@ void Halite::rank_players(){
     impl->rank_players();
 }
 
+/**
+ * Save the game state between turns, reusing the buffers of a snapshot.
+ * @param[out] snapshot The snapshot.
+ */
+void Halite::snapshot(GameSnapshot &snapshot) const {
+    snapshot.turn_number = turn_number;
+    snapshot.rng = rng;
+    snapshot.cells.assign(map.grid.begin(), map.grid.end());
+    store.save(snapshot);
+}
+
+/**
+ * Save the game state between turns.
+ * @return The snapshot.
+ */
+GameSnapshot Halite::snapshot() const {
+    GameSnapshot saved;
+    snapshot(saved);
+    return saved;
+}
+
+/**
+ * Restore a game state saved from this game, or from a game set up on the same map with the same players.
+ * The statistics are left as they are.
+ * @param snapshot The snapshot.
+ */
+void Halite::restore(const GameSnapshot &snapshot) {
+    assert(snapshot.cells.size() == map.grid.size());
+    turn_number = snapshot.turn_number;
+    rng = snapshot.rng;
+    std::copy(snapshot.cells.begin(), snapshot.cells.end(), map.grid.begin());
+    store.restore(snapshot);
+    occupancy.update(store, map);
+}
+
+/**
+ * Copy the game into a fork with its own map and statistics, to be played out apart from this game.
+ * @return The fork.
+ */
+std::unique_ptr<GameFork> Halite::fork() const {
+    return std::make_unique<GameFork>(*this);
+}
+
 /** Default destructor is defined where HaliteImpl is complete. */
 Halite::~Halite() = default;
 
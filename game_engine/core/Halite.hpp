@@ -1,7 +1,14 @@
 #ifndef HALITE_H
 #define HALITE_H
 
+#include "CaptureField.hpp"
+#include "Constants.hpp"
+#include "DestinationGrid.hpp"
+#include "GameSnapshot.hpp"
+#include "InspirationField.hpp"
+#include "PlayerBitboards.hpp"
 #include "Store.hpp"
+#include "TurnCommands.hpp"
 #include "mapgen/Generator.hpp"
 #include <memory>
 
@@ -9,6 +16,8 @@ namespace hlt {
 
 struct GameStatistics;
 
+class GameFork;
+
 class HaliteImpl;
 
 struct Replay;
@@ -16,25 +25,43 @@ struct Replay;
 /** Halite game interface, exposing the top level of the game. */
 class Halite final {
     /** Transient game state. */
+    InspirationField inspiration;     /**< Ships near each cell, for inspiration. */
+    CaptureField capture;             /**< Ships near each cell, for capture. */
+    PlayerBitboards occupancy;        /**< The cells of each player's ships and structures. */
+    DestinationGrid destinations;     /**< Scratch space for resolving moves. */
 
 
     /** Friend classes have full access to game state. */
 
     friend class HaliteImpl;
-
-    std::unique_ptr<HaliteImpl> impl; /**< The pointer to implementation. */
-    std::mt19937 rng;                 /** The random number generator used for tie breaking. */
+    friend class GameFork;
 
 public:
     /** External game state. */
     GameStatistics &game_statistics;  /**< The statistics of the game. */
 
     unsigned long turn_number{};      /**< The turn number. */
+    GameConfig config;                /**< The settings of this game. */
     //Replay &replay;                   /**< Replay instance to collect info for visualizer. */
     //PlayerLogs logs;                  /**< The player logs. */
     Store store;                      /**< The entity store. */
     Map &map;                         /**< The game map. */
 
+private:
+    /** Declared after the game state, so the implementation is constructed once all of it is. */
+    std::unique_ptr<HaliteImpl> impl; /**< The pointer to implementation. */
+    std::mt19937 rng;                 /** The random number generator used for tie breaking. */
+
+    /**
+     * Constructor for a fork, continuing from the state of another game.
+     *
+     * @param map The copy of the parent's map.
+     * @param game_statistics The copy of the parent's statistics.
+     * @param parent The game to continue from.
+     */
+    Halite(Map &map, GameStatistics &game_statistics, const Halite &parent);
+
+public:
     /**
      * Constructor for the main game.
      *
@@ -42,10 +69,12 @@ public:
      * @param networking_config The networking configuration.
      * @param game_statistics The game statistics to use.
      * @param replay The game replay to use.
+     * @param config The settings of this game, by default the global constants.
      */
     Halite(Map &map,
            GameStatistics &game_statistics,
-           Replay &replay);
+           Replay &replay,
+           const GameConfig &config = Constants::get());
 
     /**
      * Run the game.
@@ -60,8 +89,17 @@ public:
 
     void update_inspiration();
     
-    /** Retrieve and process commands, and update the game state for the current turn. */
-    void process_turn(std::map<long, std::vector<AgentCommand>> rawCommands);
+    /**
+     * Parse string commands, then process them as typed commands.
+     * @param rawCommands The commands of each player, by player ID.
+     */
+    void process_turn(const std::map<long, std::vector<AgentCommand>> &rawCommands);
+
+    /**
+     * Process typed commands, and update the game state for the current turn.
+     * @param commands The commands of each player.
+     */
+    void process_turn(const TurnCommands &commands);
     
     bool game_ended();
     
@@ -69,6 +107,37 @@ public:
     
     void update_player_stats();
 
+    /**
+     * Save the game state between turns, reusing the buffers of a snapshot.
+     * @param[out] snapshot The snapshot.
+     */
+    void snapshot(GameSnapshot &snapshot) const;
+
+    /**
+     * Save the game state between turns.
+     * @return The snapshot.
+     */
+    GameSnapshot snapshot() const;
+
+    /**
+     * Restore a game state saved from this game, or from a game set up on the same map with the same players.
+     * The statistics are left as they are.
+     * @param snapshot The snapshot.
+     */
+    void restore(const GameSnapshot &snapshot);
+
+    /**
+     * Copy the game into a fork with its own map and statistics, to be played out apart from this game.
+     * @return The fork.
+     */
+    std::unique_ptr<GameFork> fork() const;
+
+    /**
+     * Get the cells of each player's ships and structures, as of the last statistics update or restore.
+     * @return The bitboards, empty if the map is too wide for them.
+     */
+    const PlayerBitboards &bitboards() const { return occupancy; }
+
 };
 
 }
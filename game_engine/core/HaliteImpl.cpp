@@ -1,30 +1,47 @@
+#include <array>
 #include <future>
 #include <set>
+#include <utility>
 
 #include "HaliteImpl.hpp"
+#include "Profiler.hpp"
 
 namespace hlt {
 
+namespace {
+
+/** The distance within which entities of different players may interact. */
+constexpr dimension_type INTERACTION_RADIUS = 2;
+
+/** The offsets of the cells within INTERACTION_RADIUS of a cell, including the cell itself. */
+constexpr std::array<std::pair<dimension_type, dimension_type>, 13> INTERACTION_OFFSETS{{
+    {0, 0},
+    {1, 0}, {-1, 0}, {0, 1}, {0, -1},
+    {2, 0}, {-2, 0}, {0, 2}, {0, -2},
+    {1, 1}, {1, -1}, {-1, 1}, {-1, -1},
+}};
+
+}
+
 /**
  * Initialize the game.
  * @param player_commands The list of player commands.
  */
 void HaliteImpl::initialize_game(int n_players) {
     // Update max turn # by map size (300 @ 32x32 to 500 at 80x80)
-    auto &mut_constants = Constants::get_mut();
-    auto turns = mut_constants.MIN_TURNS;
+    auto &constants = game.config;
+    auto turns = constants.MIN_TURNS;
     const unsigned long max_dimension = std::max(game.map.width, game.map.height);
-    if (max_dimension > mut_constants.MIN_TURN_THRESHOLD) {
-        turns += static_cast<unsigned long>(((max_dimension - mut_constants.MIN_TURN_THRESHOLD) / static_cast<double>(mut_constants.MAX_TURN_THRESHOLD - mut_constants.MIN_TURN_THRESHOLD)) * (mut_constants.MAX_TURNS - mut_constants.MIN_TURNS));
+    if (max_dimension > constants.MIN_TURN_THRESHOLD) {
+        turns += static_cast<unsigned long>(((max_dimension - constants.MIN_TURN_THRESHOLD) / static_cast<double>(constants.MAX_TURN_THRESHOLD - constants.MIN_TURN_THRESHOLD)) * (constants.MAX_TURNS - constants.MIN_TURNS));
     }
-    mut_constants.MAX_TURNS = turns;
+    constants.MAX_TURNS = turns;
 
-    const auto &constants = Constants::get();
     auto &players = game.store.players;
     //assert(game.map.factories.size() >= player_commands.size());
 
     // Add a 0 frame so we can record beginning-of-game state
-    std::unordered_set<Location> changed_cells;
+    std::vector<Location> changed_cells;
 
     auto factory_iterator = game.map.factories.begin();
 
@@ -63,245 +80,264 @@ void HaliteImpl::run_game() {
     //removed
 }
 
-void HaliteImpl::parse(AgentCommand agentCommand, std::unique_ptr<Command> &command) {
-    // Read one character corresponding to the type, and dispatch the remainder based on its value.
-    auto entityId = agentCommand.first;
-    auto agentCommandText = agentCommand.second;
-
-    char command_type;
-    if (agentCommandText == "N" || agentCommandText == "E" || agentCommandText == "S" || agentCommandText == "W" || agentCommandText == "still") {
-        Entity::id_type entity(agentCommand.first);
-        Direction direction;
+/**
+ * Convert a string command to a typed command, exiting on an unknown command.
+ * @param agentCommand The entity or player ID, and the command text.
+ * @return The typed command.
+ */
+TypedAgentCommand HaliteImpl::parse(const AgentCommand &agentCommand) {
+    const auto &agentCommandText = agentCommand.second;
+    if (agentCommandText == "N") {
+        return {agentCommand.first, AgentAction::North};
+    } else if (agentCommandText == "E") {
+        return {agentCommand.first, AgentAction::East};
+    } else if (agentCommandText == "S") {
+        return {agentCommand.first, AgentAction::South};
+    } else if (agentCommandText == "W") {
+        return {agentCommand.first, AgentAction::West};
+    } else if (agentCommandText == "still") {
+        return {agentCommand.first, AgentAction::Still};
+    } else if (agentCommandText == "spawn") {
+        return {agentCommand.first, AgentAction::Spawn};
+    } else if (agentCommandText == "construct") {
+        return {agentCommand.first, AgentAction::Construct};
+    }
+    std::cout << "You didn't set command! What's wrong with you?" << std::endl;
+    exit(1);
+}
 
-        if (agentCommandText == "N"){
-            direction = Direction::North;
-        }
-        else if (agentCommandText == "E"){
-            direction = Direction::East;
-        }
-        else if (agentCommandText == "S"){
-            direction = Direction::South;
-        }
-        else if (agentCommandText == "W"){
-            direction = Direction::West;
-        }
-        else if (agentCommandText == "still"){
-            direction = Direction::Still;
+/**
+ * Convert string commands, then process them as typed commands.
+ * @param rawCommands The commands of each player, by player ID.
+ */
+void HaliteImpl::process_turn(const std::map<long, std::vector<AgentCommand>> &rawCommands) {
+    // Players up to the highest ID given take part, with no commands if they have none.
+    const auto players = rawCommands.empty() ? 0 : static_cast<std::size_t>(rawCommands.rbegin()->first + 1);
+    {
+        HALITE_PROFILE_SCOPE(Convert, game.map.width, game.map.height);
+        parsed_commands.clear(players);
+        for (const auto &[player_id, raw] : rawCommands) {
+            for (const auto &rawCommand : raw) {
+                parsed_commands.add(player_id, parse(rawCommand));
+            }
         }
-        //istream >> entity >> direction;
-        command = std::make_unique<MoveCommand>(entity, direction);
-    }
-    else if (agentCommandText == "spawn") {
-        command = std::make_unique<SpawnCommand>();
-    }
-    else if (agentCommandText == "construct") {
-        Entity::id_type entity(agentCommand.first);
-        command = std::make_unique<ConstructCommand>(entity);
-    }
-    else {
-        std::cout << "You didn't set command! What's wrong with you?" << std::endl;
-        exit(1);
     }
+    process_turn(parsed_commands);
 }
 
-/** Retrieve and process commands, and update the game state for the current turn. */
-void HaliteImpl::process_turn(std::map<long, std::vector<AgentCommand>> rawCommands) {
+/**
+ * Process typed commands, and update the game state for the current turn.
+ * @param commands The commands of each player.
+ */
+void HaliteImpl::process_turn(const TurnCommands &commands) {
+    HALITE_PROFILE_SCOPE(Turn, game.map.width, game.map.height);
 
     //Reset list of self-collided ships
     game.store.selfCollidedEntities.clear();
 
-    // Retrieve all commands
-    using Commands = std::vector<std::unique_ptr<Command>>;
-    ordered_id_map<Player, Commands> commands{};
-
-    auto &players = game.store.players;
-
-    for(uint i = 0; i < rawCommands.size(); i++) {
-        auto playerRawCommands = rawCommands[i];
-
-        for(auto playerPair: players){
-            //Find the player who owns these commands. This is ugly I know.
-            auto playerId = playerPair.first.value;
-            auto player = playerPair.second;
-            if(playerId == i) {
-
-                Commands currentCommands;
-
-                for (auto rawCommand : playerRawCommands) {
-
-                    std::unique_ptr<Command> command;
-                    //Convert from our command system into the game's command system
-                    parse(rawCommand, command);
-                    currentCommands.push_back(std::move(command));
+    // Store the commands of each player by value, in the order given.
+    {
+        HALITE_PROFILE_SCOPE(Parse, game.map.width, game.map.height);
+        if (player_commands.size() < commands.players()) {
+            player_commands.resize(commands.players());
+        }
+        commanding_players.clear();
+        for (std::size_t index = 0; index < commands.players(); index++) {
+            const Player::id_type player_id(static_cast<long>(index));
+            if (game.store.players.find(player_id) == game.store.players.end()) {
+                continue;
+            }
+            commanding_players.push_back(player_id);
+
+            auto &stored = player_commands[index];
+            stored.clear();
+            for (const auto &command : commands.of(index)) {
+                const Entity::id_type entity(command.entity);
+                switch (command.action) {
+                case AgentAction::North:
+                    stored.emplace_back(std::in_place_type<MoveCommand>, entity, Direction::North);
+                    break;
+                case AgentAction::East:
+                    stored.emplace_back(std::in_place_type<MoveCommand>, entity, Direction::East);
+                    break;
+                case AgentAction::South:
+                    stored.emplace_back(std::in_place_type<MoveCommand>, entity, Direction::South);
+                    break;
+                case AgentAction::West:
+                    stored.emplace_back(std::in_place_type<MoveCommand>, entity, Direction::West);
+                    break;
+                case AgentAction::Still:
+                    stored.emplace_back(std::in_place_type<MoveCommand>, entity, Direction::Still);
+                    break;
+                case AgentAction::Spawn:
+                    stored.emplace_back(std::in_place_type<SpawnCommand>);
+                    break;
+                case AgentAction::Construct:
+                    stored.emplace_back(std::in_place_type<ConstructCommand>, entity);
+                    break;
                 }
-
-                commands[playerPair.first] = std::move(currentCommands);
             }
         }
     }
 
-
     // Process valid player commands, removing players if they submit invalid ones.
-    std::unordered_set<Entity::id_type> changed_entities;
-    while (!commands.empty()) {
+    changed_entities.clear();
+    while (!commanding_players.empty()) {
         changed_entities.clear();
         game.store.changed_cells.clear();
 
-        CommandTransaction transaction{game.store, game.map};
-        std::unordered_set<Player::id_type> offenders;
+        CommandTransaction transaction{game.store, game.map, game.config, game.destinations};
+        offenders.assign(player_commands.size(), false);
         // transaction.on_event([&frames = game.replay.full_frames, this](GameEvent event) {
         //     event->update_stats(game.store, game.map, game.game_statistics);
         //     // Create new game event for replay file.
         //     frames.back().events.push_back(std::move(event));
         // });
-        transaction.on_error([&offenders, &commands, this](CommandError error) {
-            this->handle_error(offenders, commands, std::move(error));
+        transaction.on_error([this](CommandError error) {
+            this->handle_error(std::move(error));
         });
 
         transaction.on_cell_update([&changed_cells = game.store.changed_cells](Location cell) {
-            changed_cells.emplace(cell);
+            changed_cells.push_back(cell);
         });
-        transaction.on_entity_update([&changed_entities](Entity::id_type entity) {
-            changed_entities.emplace(entity);
+        transaction.on_entity_update([&changed_entities = changed_entities](Entity::id_type entity) {
+            changed_entities.push_back(entity);
         });
 
-        for (const auto &[player_id, command_list] : commands) {
-            auto &player = game.store.players.find(player_id)->second;
-            for (const auto &command : command_list) {
-                command->add_to_transaction(player, transaction);
+        bool checked;
+        {
+            HALITE_PROFILE_SCOPE(Check, game.map.width, game.map.height);
+            for (const auto &player_id : commanding_players) {
+                auto &player = game.store.players.find(player_id)->second;
+                for (const auto &command : player_commands[player_id.value]) {
+                    std::visit([&player, &transaction](const auto &typed) {
+                        transaction.add_command(player, typed);
+                    }, command);
+                }
             }
+            checked = transaction.check();
         }
-        if (transaction.check()) {
+        if (checked) {
             // All commands are successful.
-            transaction.commit();
-            if (Constants::get().STRICT_ERRORS) {
-                if (!offenders.empty()) {
+            {
+                HALITE_PROFILE_SCOPE(Commit, game.map.width, game.map.height);
+                transaction.commit();
+            }
+            const bool any_offenders = std::find(offenders.begin(), offenders.end(), true) != offenders.end();
+            if (game.config.STRICT_ERRORS) {
+                if (any_offenders) {
                     std::cout << "Command processing failed for players: ";
-                    for (auto iterator = offenders.begin(); iterator != offenders.end(); iterator++) {
-                        std::cout << *iterator;
-                        if (std::next(iterator) != offenders.end()) {
-                            std::cout << ", ";
+                    const char *separator = "";
+                    for (std::size_t index = 0; index < offenders.size(); index++) {
+                        if (offenders[index]) {
+                            std::cout << separator << index;
+                            separator = ", ";
                         }
                     }
                     std::cout << ", aborting due to strict error check";
                     //Logging::log(stream.str(), Logging::Level::Error);
-                    game.turn_number = Constants::get().MAX_TURNS;
+                    game.turn_number = game.config.MAX_TURNS;
                     exit(1);
                     return;
                 }
             } else {
-                assert(offenders.empty());
+                assert(!any_offenders);
             }
             // Add player commands to replay and note players still alive
             //game.replay.full_frames.back().moves = std::move(commands);
             break;
         } else {
-            for (auto player : offenders) {
-                kill_player(player);
-                commands.erase(player);
+            for (std::size_t index = 0; index < offenders.size(); index++) {
+                if (offenders[index]) {
+                    const Player::id_type player(static_cast<long>(index));
+                    kill_player(player);
+                    commanding_players.erase(std::remove(commanding_players.begin(), commanding_players.end(), player),
+                                             commanding_players.end());
+                }
             }
         }
     }
 
     // Resolve ship mining
-    const auto max_energy = Constants::get().MAX_ENERGY;
-    const auto ships_threshold = Constants::get().SHIPS_ABOVE_FOR_CAPTURE;
-    const auto bonus_multiplier = Constants::get().INSPIRED_BONUS_MULTIPLIER;
-    for (auto &[entity_id, entity] : game.store.entities) {
-        if (changed_entities.find(entity_id) == changed_entities.end()
-            && entity.energy < max_energy) {
-            // Allow this entity to extract
-            const auto location = game.store.get_player(entity.owner).get_entity_location(entity_id);
-            auto &cell = game.map.at(location);
-
-            const auto ratio = entity.is_inspired ?
-                Constants::get().INSPIRED_EXTRACT_RATIO :
-                Constants::get().EXTRACT_RATIO;
-            energy_type extracted = static_cast<energy_type>(
-                std::ceil(static_cast<double>(cell.energy) / ratio));
-            energy_type gained = extracted;
-
-            // If energy is small, give it all to the entity.
-            if (extracted == 0 && cell.energy > 0) {
-                extracted = gained = cell.energy;
-            }
+    {
+        HALITE_PROFILE_SCOPE(Mining, game.map.width, game.map.height);
+        std::sort(changed_entities.begin(), changed_entities.end());
+        const auto max_energy = game.config.MAX_ENERGY;
+        const auto bonus_multiplier = game.config.INSPIRED_BONUS_MULTIPLIER;
+        for (auto &entity : game.store.entities) {
+            if (!std::binary_search(changed_entities.begin(), changed_entities.end(), entity.id)
+                && entity.energy < max_energy) {
+                // Allow this entity to extract
+                const auto location = entity.location;
+                auto &cell = game.map.at(location);
+
+                const auto ratio = entity.is_inspired ?
+                    game.config.INSPIRED_EXTRACT_RATIO :
+                    game.config.EXTRACT_RATIO;
+                energy_type extracted = static_cast<energy_type>(
+                    std::ceil(static_cast<double>(cell.energy) / ratio));
+                energy_type gained = extracted;
+
+                // If energy is small, give it all to the entity.
+                if (extracted == 0 && cell.energy > 0) {
+                    extracted = gained = cell.energy;
+                }
 
-            // Don't take more than the entity can hold.
-            if (extracted + entity.energy > max_energy) {
-                extracted = max_energy - entity.energy;
-            }
+                // Don't take more than the entity can hold.
+                if (extracted + entity.energy > max_energy) {
+                    extracted = max_energy - entity.energy;
+                }
 
-            // Apply bonus for inspired entities
-            if (entity.is_inspired && bonus_multiplier > 0) {
-                gained += bonus_multiplier * gained;
-            }
+                // Apply bonus for inspired entities
+                if (entity.is_inspired && bonus_multiplier > 0) {
+                    gained += bonus_multiplier * gained;
+                }
 
-            // Do not allow entity to exceed capacity.
-            if (max_energy - entity.energy < gained) {
-                gained = max_energy - entity.energy;
-            }
-            auto &player_stats = game.game_statistics.player_statistics.at(entity.owner.value);
-            player_stats.total_mined += extracted;
-            player_stats.total_bonus += gained > extracted ? gained - extracted : 0;
-            if (entity.was_captured) {
-                player_stats.total_mined_from_captured += gained;
+                // Do not allow entity to exceed capacity.
+                if (max_energy - entity.energy < gained) {
+                    gained = max_energy - entity.energy;
+                }
+                auto &player_stats = game.game_statistics.player_statistics.at(entity.owner.value);
+                player_stats.total_mined += extracted;
+                player_stats.total_bonus += gained > extracted ? gained - extracted : 0;
+                if (entity.was_captured) {
+                    player_stats.total_mined_from_captured += gained;
+                }
+                entity.energy += gained;
+                cell.energy -= extracted;
+                game.store.map_total_energy -= extracted;
+                game.store.changed_cells.push_back(location);
             }
-            entity.energy += gained;
-            cell.energy -= extracted;
-            game.store.map_total_energy -= extracted;
-            game.store.changed_cells.emplace(location);
         }
     }
 
     // Resolve ship capture
-    if (Constants::get().CAPTURE_ENABLED) {
-        const auto capture_radius = Constants::get().CAPTURE_RADIUS;
-        std::unordered_map<Location, Player::id_type> entity_switches;
+    if (game.config.CAPTURE_ENABLED) {
+        HALITE_PROFILE_SCOPE(Capture, game.map.width, game.map.height);
+        const auto ships_threshold = game.config.SHIPS_ABOVE_FOR_CAPTURE;
+        game.capture.compute(game.store, game.map, game.config.CAPTURE_RADIUS);
+        captures.clear();
         for (const auto &[player_id, player] : game.store.players) {
-            for (const auto &[entity_id, location] : player.entities) {
-                id_map<Player, unsigned long> ships_in_radius;
-                for(const auto &[pid, _] : game.store.players) ships_in_radius[pid] = 0;
-
-                std::unordered_set<Location> visited_locs{};
-                std::unordered_set<Location> to_visit_locs{location};
-                while(!to_visit_locs.empty()) {
-                    const Location cur = *to_visit_locs.begin();
-                    visited_locs.emplace(cur);
-                    to_visit_locs.erase(to_visit_locs.begin());
-
-                    Cell cur_cell = game.map.at(cur);
-                    if(cur_cell.entity != Entity::None) {
-                        ships_in_radius[game.store.get_entity(cur_cell.entity).owner]++;
-                    }
-
-                    for(const Location &neighbor : game.map.get_neighbors(cur)) {
-                        if((visited_locs.find(neighbor) == visited_locs.end())
-                           && (to_visit_locs.find(neighbor) == to_visit_locs.end())) {
-                            if(game.map.distance(location, neighbor) <= capture_radius) {
-                                to_visit_locs.emplace(neighbor);
-                            } else {
-                                visited_locs.emplace(neighbor);
-                            }
-                        }
-                    }
-                }
+            for (const auto &entity_id : player.entities) {
+                const auto location = game.store.get_entity(entity_id).location;
 
                 unsigned long max_val = 0;
                 Player::id_type max_id = Player::None;
-                for(const auto &[pid, val] : ships_in_radius) {
+                for(const auto &[pid, _] : game.store.players) {
+                    const auto val = game.capture.count(pid, location);
                     if(pid != player_id && val > max_val) {
                         max_val = val;
                         max_id = pid;
                     }
                 }
-                if(ships_in_radius[player_id]+ships_threshold <= max_val) {
-                    entity_switches[location] = max_id;
+                if(game.capture.count(player_id, location)+ships_threshold <= max_val) {
+                    captures.emplace_back(location, max_id);
                 }
             }
         }
 
         // Flip the ships that have been captured
-        for(const auto &[location, new_player_id] : entity_switches) {
+        for(const auto &[location, new_player_id] : captures) {
             auto &cell = game.map.at(location);
             const auto entity = game.store.get_entity(cell.entity);
 
@@ -309,14 +345,10 @@ void HaliteImpl::process_turn(std::map<long, std::vector<AgentCommand>> rawComma
             game.game_statistics.player_statistics.at(new_player_id.value).ships_captured++;
 
             game.store.delete_entity(entity.id);
-            auto &entities = game.store.get_player(entity.owner).entities;
-            entities.erase(entities.find(entity.id));
 
-            auto new_entity = game.store.new_entity(entity.energy, new_player_id);
-            // XXX new_entity seems to be a copy not a real reference
+            auto &new_entity = game.store.new_entity(entity.energy, new_player_id, location);
+            new_entity.was_captured = true;
             cell.entity = new_entity.id;
-            game.store.get_entity(new_entity.id).was_captured = true;
-            game.store.get_player(new_player_id).add_entity(new_entity.id, location);
 
             //game.replay.full_frames.back().events.push_back(std::make_unique<CaptureEvent>(location, entity.owner, entity.id, new_player_id, new_entity.id));
         }
@@ -327,53 +359,17 @@ void HaliteImpl::process_turn(std::map<long, std::vector<AgentCommand>> rawComma
 }
 
 void HaliteImpl::update_inspiration() {
-    if (!Constants::get().INSPIRATION_ENABLED) {
+    HALITE_PROFILE_SCOPE(Inspiration, game.map.width, game.map.height);
+    if (!game.config.INSPIRATION_ENABLED) {
         return;
     }
 
-    const auto inspiration_radius = Constants::get().INSPIRATION_RADIUS;
-    const auto ships_threshold = Constants::get().INSPIRATION_SHIP_COUNT;
-
-    // Check every ship of every player
-    for (const auto &[player_id, player] : game.store.players) {
-        for (const auto &[entity_id, location] : player.entities) {
-            // map from player ID to # of ships within the inspiration
-            // radius of the current ship
-            id_map<Player, long> ships_in_radius;
-            for (const auto &[pid, _] : game.store.players) {
-                ships_in_radius[pid] = 0;
-            }
-
-            // Explore locations around this ship
-            for (auto dx = -inspiration_radius; dx <= inspiration_radius; dx++) {
-                for (auto dy = -inspiration_radius; dy <= inspiration_radius; dy++) {
-                    const auto cur = Location{
-                        (((location.x + dx) % game.map.width) + game.map.width) % game.map.width,
-                        (((location.y + dy) % game.map.height) + game.map.height) % game.map.height
-                    };
-
-                    const auto &cur_cell = game.map.at(cur);
-                    if (cur_cell.entity == Entity::None ||
-                        game.map.distance(location, cur) > inspiration_radius) {
-                        continue;
-                    }
-                    const auto &other_entity = game.store.get_entity(cur_cell.entity);
-                    ships_in_radius[other_entity.owner]++;
-                }
-            }
+    const auto ships_threshold = game.config.INSPIRATION_SHIP_COUNT;
+    game.inspiration.sync(game.store, game.map, game.config.INSPIRATION_RADIUS);
 
-            // Total up ships of other player
-            unsigned long opponent_entities = 0;
-            for (const auto &[pid, count] : ships_in_radius) {
-                if (pid != player_id) {
-                    opponent_entities += count;
-                }
-            }
-
-            // Mark ship as inspired or not
-            auto &entity = game.store.get_entity(entity_id);
-            entity.is_inspired = opponent_entities >= ships_threshold;
-        }
+    // Mark each ship as inspired or not
+    for (auto &entity : game.store.entities) {
+        entity.is_inspired = game.inspiration.opponents(entity.owner, entity.location) >= ships_threshold;
     }
 }
 
@@ -384,7 +380,7 @@ void HaliteImpl::update_inspiration() {
  * @return True if the player can play on the next turn
  */
 bool HaliteImpl::player_can_play(const Player &player) const {
-    return !player.entities.empty() || player.energy >= Constants::get().NEW_ENTITY_ENERGY_COST;
+    return !player.entities.empty() || player.energy >= game.config.NEW_ENTITY_ENERGY_COST;
 }
 /**
  * Determine whether the game has ended.
@@ -396,7 +392,7 @@ bool HaliteImpl::game_ended() const {
         return std::all_of(all_entities.begin(),
                            all_entities.end(),
                            [](const auto& entity) {
-                               return entity.second.energy == 0;
+                               return entity.energy == 0;
                            });
     }
     long num_alive_players = 0;
@@ -422,6 +418,9 @@ bool HaliteImpl::game_ended() const {
  * Update all players' statistics after a single turn.
  */
 void HaliteImpl::update_player_stats() {
+    HALITE_PROFILE_SCOPE(PlayerStats, game.map.width, game.map.height);
+    game.occupancy.update(game.store, game.map);
+    const bool use_bitboards = game.occupancy.supported();
     for (PlayerStatistics &player_stats : game.game_statistics.player_statistics) {
         // Player with sprites is still alive, so mark as alive on this turn and add production gained
         const auto &player_id = player_stats.player_id;
@@ -433,13 +432,18 @@ void HaliteImpl::update_player_stats() {
             player_stats.turn_productions.push_back(player.energy);
             player_stats.turn_deposited.push_back(player.total_energy_deposited);
             player_stats.number_dropoffs = player.dropoffs.size();
-            for (const auto &[_entity_id, location] : player.entities) {
+            if (use_bitboards) {
+                // One pass over the rows finds every cell near another player.
+                game.occupancy.opponents_within(player_id, INTERACTION_RADIUS, interaction_range);
+            }
+            for (const auto &entity_id : player.entities) {
+                const auto location = game.store.get_entity(entity_id).location;
                 const dimension_type entity_distance = game.map.distance(location, player.factory);
                 if (entity_distance > player_stats.max_entity_distance)
                     player_stats.max_entity_distance = entity_distance;
                 player_stats.total_distance += entity_distance;
                 player_stats.total_entity_lifespan++;
-                if (possible_interaction(player_id, location)) {
+                if (use_bitboards ? interaction_range.test(location) : possible_interaction(player_id, location)) {
                     player_stats.interaction_opportunities++;
                 }
             }
@@ -458,31 +462,38 @@ void HaliteImpl::update_player_stats() {
 
 /**
  * Determine if entity owned by given player is in range of another player (their entity, dropoff, or factory) and thus may interact
+ * Used for maps too wide for bitboards; otherwise the statistics update tests a precomputed range instead.
  *
  * param owner_id Id of owner of entity at given location
  * param entity_location Location of entity we are assessing for an interaction opportunity
  * return bool Indicator of whether there players are in close range for an interaction (true) or not (false)
  */
 bool HaliteImpl::possible_interaction(const Player::id_type owner_id, const Location entity_location) {
-    // Fetch all locations 2 cells away
-    std::unordered_set<Location> close_cells{};
-    const auto neighbors = game.map.get_neighbors(entity_location);
-    close_cells.insert(neighbors.begin(), neighbors.end());
-    for (const Location &neighbor : neighbors) {
-        const auto cells_once_removed = game.map.get_neighbors(neighbor);
-        close_cells.insert(cells_once_removed.begin(), cells_once_removed.end());
-    }
     // Interaction possibilty implies a cell has an entity owned by another player or there is a factory or dropoff
     // of another player on the cell. Interactions between entities of a single player are ignored
-    for (const Location &cell_location : close_cells) {
-        const Cell &cell = game.map.at(cell_location);
+    const auto interacts = [this, owner_id](const Cell &cell) {
         if (cell.entity != Entity::None) {
             if (game.store.get_entity(cell.entity).owner != owner_id) return true;
         }
-        if (cell.owner != Player::None && cell.owner != owner_id) return true;
+        return cell.owner != Player::None && cell.owner != owner_id;
+    };
+
+    const auto &map = game.map;
+    const auto [x, y] = entity_location;
+    if (x >= INTERACTION_RADIUS && x < map.width - INTERACTION_RADIUS
+        && y >= INTERACTION_RADIUS && y < map.height - INTERACTION_RADIUS) {
+        // No cell of the neighborhood wraps around the edges.
+        for (const auto &[dx, dy] : INTERACTION_OFFSETS) {
+            if (interacts(map.at(x + dx, y + dy))) return true;
+        }
+    } else {
+        for (const auto &[dx, dy] : INTERACTION_OFFSETS) {
+            const auto cell_x = ((x + dx) % map.width + map.width) % map.width;
+            const auto cell_y = ((y + dy) % map.height + map.height) % map.height;
+            if (interacts(map.at(cell_x, cell_y))) return true;
+        }
     }
     return false;
-
 }
 
 /**
@@ -514,12 +525,9 @@ void HaliteImpl::kill_player(const Player::id_type &player_id) {
     player.terminated = true;
     //game.networking.kill_player(player);
 
-    auto &entities = player.entities;
-    for (auto entity_iterator = entities.begin();
-         entity_iterator != entities.end();
-         entity_iterator = entities.erase(entity_iterator)) {
-        const auto &[entity_id, location] = *entity_iterator;
-        auto &cell = game.map.at(location);
+    while (!player.entities.empty()) {
+        const auto entity_id = player.entities.back();
+        auto &cell = game.map.at(game.store.get_entity(entity_id).location);
         cell.entity = Entity::None;
         game.store.delete_entity(entity_id);
     }
@@ -534,13 +542,9 @@ HaliteImpl::HaliteImpl(Halite &game) : game(game) {}
 
 /**
  * Handle a player command error.
- * @param offenders The set of players this turn who have caused errors.
- * @param commands The player command mapping.
  * @param error The error caused by the player.
  */
-void HaliteImpl::handle_error(std::unordered_set<Player::id_type> &offenders,
-                              ordered_id_map<Player, std::vector<std::unique_ptr<Command>>> &commands,
-                              CommandError error) {
+void HaliteImpl::handle_error(CommandError error) {
     const auto message = error->log_message();
     const auto &faulty = error->command();
     const auto player_id = error->player;
@@ -553,15 +557,17 @@ void HaliteImpl::handle_error(std::unordered_set<Player::id_type> &offenders,
     } else {
         //Logging::log(message, Logging::Level::Error, player_id);
         //std::cout << message << " " << player_id << std::endl;
-        offenders.emplace(player_id);
+        offenders[player_id.value] = true;
         //game.logs.log(player_id, message, PlayerLog::Level::Error);
     }
 
     // Find the position of a command within a player's command list.
-    auto &player_commands = commands[player_id];
+    auto &player_commands = this->player_commands[player_id.value];
     const auto find_position = [&player_commands](const Command &faulty) {
         return std::find_if(player_commands.begin(), player_commands.end(), [&faulty](const auto &command) {
-            return std::addressof(*command) == std::addressof(faulty);
+            return std::visit([&faulty](const Command &stored) {
+                return std::addressof(stored) == std::addressof(faulty);
+            }, command);
         });
     };
 
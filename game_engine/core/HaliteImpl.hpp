@@ -2,7 +2,11 @@
 #define HALITEIMPL_HPP
 
 #include <queue>
+#include <utility>
+#include <variant>
+#include <vector>
 
+#include "Command.hpp"
 #include "CommandTransaction.hpp"
 #include "Halite.hpp"
 #include "Replay.hpp"
@@ -17,6 +21,30 @@ class HaliteImpl final {
     /** The game interface. */
     Halite &game;
 
+    /** Scratch bitboard of the cells near other players, reused by every statistics update. */
+    Bitboard interaction_range;
+
+    /** The entities moved or placed by the commands of the current turn, reused every turn. */
+    std::vector<Entity::id_type> changed_entities;
+
+    /** A command of any type, stored by value. */
+    using AnyCommand = std::variant<MoveCommand, SpawnCommand, ConstructCommand>;
+
+    /** The commands of each player on the current turn, indexed by player ID and reused every turn. */
+    std::vector<std::vector<AnyCommand>> player_commands;
+
+    /** The players whose commands are still being processed on the current turn, in ID order. */
+    std::vector<Player::id_type> commanding_players;
+
+    /** The typed form of the string commands of the current turn, reused every turn. */
+    TurnCommands parsed_commands;
+
+    /** Whether each player, by ID, has given a command that is an error on the current turn. */
+    std::vector<bool> offenders;
+
+    /** The ships to be captured on the current turn and the players capturing them, reused every turn. */
+    std::vector<std::pair<Location, Player::id_type>> captures;
+
     /**
      * Initialize the game.
      * @param player_commands The list of player commands.
@@ -50,7 +78,9 @@ class HaliteImpl final {
     void update_player_stats();
 
     /**
-     * Determine if entity owned by given player is in range of another player (their entity, dropoff, or factory) and thus may interact
+     * Determine if entity owned by given player is in range of another player (their entity, dropoff, or factory) and thus may interact.
+     *
+     * Used for maps too wide for bitboards; otherwise the statistics update tests a precomputed range instead.
      *
      * param owner_id Id of owner of entity at given location
      * param entity_location Location of entity we are assessing for an interaction opportunity
@@ -68,23 +98,33 @@ class HaliteImpl final {
     /** Update the inspiration flag on entities based on the current game state. */
     void update_inspiration();
 
-    void parse(AgentCommand agentCommand, std::unique_ptr<Command> &command);
+    /**
+     * Convert a string command to a typed command, exiting on an unknown command.
+     * @param agentCommand The entity or player ID, and the command text.
+     * @return The typed command.
+     */
+    TypedAgentCommand parse(const AgentCommand &agentCommand);
+
+    /**
+     * Parse string commands, then process them as typed commands.
+     * @param rawCommands The commands of each player, by player ID.
+     */
+    void process_turn(const std::map<long, std::vector<AgentCommand>> &rawCommands);
 
-    /** Retrieve and process commands, and update the game state for the current turn. */
-    void process_turn(std::map<long, std::vector<AgentCommand>> rawCommands);
+    /**
+     * Process typed commands, and update the game state for the current turn.
+     * @param commands The commands of each player.
+     */
+    void process_turn(const TurnCommands &commands);
 
     /** Remove a player from the game. */
     void kill_player(const Player::id_type &player_id);
 
     /**
-     * Handle a player command error.
-     * @param offenders The set of players this turn who have caused errors.
-     * @param commands The player command mapping.
+     * Handle a player command error, marking the player as an offender unless the error is ignored.
      * @param error The error caused by the player.
      */
-    void handle_error(std::unordered_set<Player::id_type> &offenders,
-                      ordered_id_map<Player, std::vector<std::unique_ptr<Command>>> &commands,
-                      CommandError error);
+    void handle_error(CommandError error);
 
 public:
     /**
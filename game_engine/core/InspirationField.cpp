@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <cassert>
+
+#include "InspirationField.hpp"
+
+namespace hlt {
+
+/**
+ * Add or remove a ship's contribution.
+ * @param ship The ship.
+ * @param delta 1 to add the ship, -1 to remove it.
+ */
+void InspirationField::stamp(const StampedShip &ship, int delta) {
+    const auto cells = totals.size();
+    auto *player_counts = counts.data() + static_cast<std::size_t>(ship.owner.value) * cells;
+    for (const auto &offset : offsets) {
+        auto x = ship.location.x + offset.x;
+        if (x >= width) {
+            x -= width;
+        }
+        auto y = ship.location.y + offset.y;
+        if (y >= height) {
+            y -= height;
+        }
+        const auto index = static_cast<std::size_t>(y * width + x);
+        player_counts[index] = static_cast<uint16_t>(player_counts[index] + delta);
+        totals[index] = static_cast<uint16_t>(totals[index] + delta);
+    }
+}
+
+/**
+ * Clear the field and size it for a map, radius and number of players.
+ * @param map The game map.
+ * @param radius The inspiration radius.
+ * @param players The number of player slots.
+ */
+void InspirationField::reset(const Map &map, dimension_type radius, std::size_t players) {
+    width = map.width;
+    height = map.height;
+    this->radius = radius;
+    this->players = players;
+
+    // A ship at S counts towards the cell S - d for every offset d of the square window that the ship at
+    // that cell would scan, as long as S is within the radius. Offsets that wrap onto the same cell on small
+    // maps are kept, so such ships are counted as many times as a scan of the window would count them.
+    offsets.clear();
+    for (auto dx = -radius; dx <= radius; dx++) {
+        for (auto dy = -radius; dy <= radius; dy++) {
+            const Location scanned{((dx % width) + width) % width, ((dy % height) + height) % height};
+            if (map.distance(Location{0, 0}, scanned) > radius) {
+                continue;
+            }
+            offsets.push_back(Location{((-dx % width) + width) % width, ((-dy % height) + height) % height});
+        }
+    }
+
+    const auto cells = static_cast<std::size_t>(width * height);
+    totals.assign(cells, 0);
+    counts.assign(players * cells, 0);
+    stamped.clear();
+}
+
+/**
+ * Bring the field up to date with the ships in the store.
+ * @param store The entity store.
+ * @param map The game map.
+ * @param radius The inspiration radius.
+ */
+void InspirationField::sync(const Store &store, const Map &map, dimension_type radius) {
+    std::size_t needed_players = 0;
+    for (const auto &[player_id, _] : store.players) {
+        needed_players = std::max(needed_players, static_cast<std::size_t>(player_id.value) + 1);
+    }
+    if (map.width != width || map.height != height || radius != this->radius || needed_players > players) {
+        reset(map, radius, needed_players);
+    }
+
+    // Both lists are in ID order, so walk them together.
+    next.clear();
+    auto previous = stamped.begin();
+    store.entities.for_each_in_id_order([this, &previous](const Entity &entity) {
+        while (previous != stamped.end() && previous->id.value < entity.id.value) {
+            stamp(*previous++, -1);
+        }
+        const StampedShip ship{entity.id, entity.owner, entity.location};
+        if (previous != stamped.end() && previous->id == entity.id) {
+            if (!(previous->owner == ship.owner && previous->location == ship.location)) {
+                stamp(*previous, -1);
+                stamp(ship, 1);
+            }
+            previous++;
+        } else {
+            assert(static_cast<std::size_t>(ship.owner.value) < players);
+            stamp(ship, 1);
+        }
+        next.push_back(ship);
+    });
+    while (previous != stamped.end()) {
+        stamp(*previous++, -1);
+    }
+    stamped.swap(next);
+}
+
+}
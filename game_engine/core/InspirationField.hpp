@@ -0,0 +1,76 @@
+#ifndef INSPIRATIONFIELD_HPP
+#define INSPIRATIONFIELD_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "Map.hpp"
+#include "Store.hpp"
+
+namespace hlt {
+
+/**
+ * Per-player counts of the ships within inspiration range of every cell, maintained incrementally.
+ *
+ * A ship adds one to its owner's count at every cell whose inspiration neighborhood contains it; the offsets of
+ * that diamond are computed once per map size and radius. Between turns, the field is synchronized with the store
+ * by walking both lists of ships in ID order, so only ships that appeared, disappeared or moved are stamped again.
+ * The number of opponent ships near a ship is then a single lookup.
+ */
+class InspirationField {
+    /** A ship as it was last stamped into the field. */
+    struct StampedShip {
+        Entity::id_type id;      /**< The ID of the ship. */
+        Player::id_type owner;   /**< The owner of the ship. */
+        Location location;       /**< The location of the ship. */
+    };
+
+    dimension_type width{};              /**< The width of the map the field was built for. */
+    dimension_type height{};             /**< The height of the map the field was built for. */
+    dimension_type radius = -1;          /**< The radius the field was built for, or -1 before the first sync. */
+    std::size_t players{};               /**< The number of player slots in the field. */
+    std::vector<Location> offsets;       /**< The cells, relative to a ship and wrapped, whose count it adds to. */
+    std::vector<uint16_t> counts;        /**< The count of each player's ships at each cell, player-major. */
+    std::vector<uint16_t> totals;        /**< The count of all ships at each cell. */
+    std::vector<StampedShip> stamped;    /**< The ships currently in the field, in ID order. */
+    std::vector<StampedShip> next;       /**< Scratch list for the next set of stamped ships. */
+
+    /**
+     * Add or remove a ship's contribution.
+     * @param ship The ship.
+     * @param delta 1 to add the ship, -1 to remove it.
+     */
+    void stamp(const StampedShip &ship, int delta);
+
+    /**
+     * Clear the field and size it for a map, radius and number of players.
+     * @param map The game map.
+     * @param radius The inspiration radius.
+     * @param players The number of player slots.
+     */
+    void reset(const Map &map, dimension_type radius, std::size_t players);
+
+public:
+    /**
+     * Bring the field up to date with the ships in the store.
+     * @param store The entity store.
+     * @param map The game map.
+     * @param radius The inspiration radius.
+     */
+    void sync(const Store &store, const Map &map, dimension_type radius);
+
+    /**
+     * Get the number of ships near a location that are not owned by a player.
+     * @param owner The player.
+     * @param location The location.
+     * @return The number of other players' ships within the inspiration radius.
+     */
+    unsigned long opponents(const Player::id_type &owner, const Location &location) const {
+        const auto index = static_cast<std::size_t>(location.y * width + location.x);
+        return totals[index] - counts[static_cast<std::size_t>(owner.value) * totals.size() + index];
+    }
+};
+
+}
+
+#endif // INSPIRATIONFIELD_HPP
@@ -0,0 +1,67 @@
+#include <algorithm>
+#include <cassert>
+
+#include "PlayerBitboards.hpp"
+
+namespace hlt {
+
+/**
+ * Rebuild the boards from the current state.
+ * @param store The entity store.
+ * @param map The game map.
+ */
+void PlayerBitboards::update(const Store &store, const Map &map) {
+    _supported = Bitboard::supports(map.width);
+    if (!_supported) {
+        _ships.clear();
+        _structures.clear();
+        return;
+    }
+
+    std::size_t players = 0;
+    for (const auto &[player_id, _] : store.players) {
+        players = std::max(players, static_cast<std::size_t>(player_id.value) + 1);
+    }
+    _ships.resize(players);
+    _structures.resize(players);
+    for (std::size_t player = 0; player < players; player++) {
+        // Resizing to the same map only clears the rows.
+        _ships[player].resize(map.width, map.height);
+        _structures[player].resize(map.width, map.height);
+    }
+
+    for (const auto &entity : store.entities) {
+        _ships[entity.owner.value].set(entity.location);
+    }
+    for (const auto &[player_id, player] : store.players) {
+        auto &structures = _structures[player_id.value];
+        structures.set(player.factory);
+        for (const auto &dropoff : player.dropoffs) {
+            structures.set(dropoff.location);
+        }
+    }
+}
+
+/**
+ * Collect the cells within a distance of a ship or structure of any other player.
+ * @param player The player whose own ships and structures are left out.
+ * @param radius The Manhattan distance, wrapping around the edges of the map.
+ * @param[out] out The cells in range, resized to the map.
+ */
+void PlayerBitboards::opponents_within(const Player::id_type &player, dimension_type radius, Bitboard &out) const {
+    assert(_supported && !_ships.empty());
+    const auto &first = _ships.front();
+    if (out.width() != first.width() || out.height() != first.height()) {
+        out.resize(first.width(), first.height());
+    } else {
+        out.clear();
+    }
+    for (std::size_t other = 0; other < _ships.size(); other++) {
+        if (other == static_cast<std::size_t>(player.value)) continue;
+        out |= _ships[other];
+        out |= _structures[other];
+    }
+    out.expand(radius);
+}
+
+}
@@ -0,0 +1,62 @@
+#ifndef PLAYERBITBOARDS_HPP
+#define PLAYERBITBOARDS_HPP
+
+#include <vector>
+
+#include "Bitboard.hpp"
+#include "Map.hpp"
+#include "Store.hpp"
+
+namespace hlt {
+
+/**
+ * The cells holding each player's ships and structures, as bitboards rebuilt from the store once per turn.
+ *
+ * Rebuilding touches only the rows of the boards and the ships and structures themselves, so it costs far less
+ * than a scan of the map. Maps wider than Bitboard::MAX_WIDTH are not supported, and leave the boards empty.
+ */
+class PlayerBitboards {
+    bool _supported = false;            /**< Whether the map of the last update fits in a bitboard. */
+    std::vector<Bitboard> _ships;       /**< The ships of each player, by player ID. */
+    std::vector<Bitboard> _structures;  /**< The factory and dropoffs of each player, by player ID. */
+
+public:
+    /**
+     * Rebuild the boards from the current state.
+     * @param store The entity store.
+     * @param map The game map.
+     */
+    void update(const Store &store, const Map &map);
+
+    /** Determine whether the map of the last update fits in a bitboard. */
+    bool supported() const { return _supported; }
+
+    /** Get the number of player slots. */
+    std::size_t players() const { return _ships.size(); }
+
+    /**
+     * Get the cells holding a player's ships.
+     * @param player The player.
+     * @return The bitboard of the ships.
+     */
+    const Bitboard &ships(const Player::id_type &player) const { return _ships[player.value]; }
+
+    /**
+     * Get the cells holding a player's factory and dropoffs.
+     * @param player The player.
+     * @return The bitboard of the structures.
+     */
+    const Bitboard &structures(const Player::id_type &player) const { return _structures[player.value]; }
+
+    /**
+     * Collect the cells within a distance of a ship or structure of any other player.
+     * @param player The player whose own ships and structures are left out.
+     * @param radius The Manhattan distance, wrapping around the edges of the map.
+     * @param[out] out The cells in range, resized to the map.
+     */
+    void opponents_within(const Player::id_type &player, dimension_type radius, Bitboard &out) const;
+};
+
+}
+
+#endif // PLAYERBITBOARDS_HPP
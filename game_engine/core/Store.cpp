@@ -1,3 +1,4 @@
+#include "GameSnapshot.hpp"
 #include "Store.hpp"
 #include <assert.h>
 
@@ -22,9 +23,7 @@ Player &Store::get_player(const Player::id_type &id) {
  * @return The entity.
  */
 Entity &Store::get_entity(const Entity::id_type &id) {
-    auto iterator = entities.find(id);
-    assert(iterator != entities.end());
-    return iterator->second;
+    return entities.at(id);
 }
 
 /**
@@ -34,33 +33,63 @@ Entity &Store::get_entity(const Entity::id_type &id) {
  * @return The entity.
  */
 const Entity &Store::get_entity(const Entity::id_type &id) const {
-    auto iterator = entities.find(id);
-    assert(iterator != entities.end());
-    return iterator->second;
+    return entities.at(id);
 }
 
 /**
- * Obtain a new entity.
+ * Obtain a new entity, and give it to its owner.
  *
  * @param energy The energy of the entity.
  * @param owner The owner of the entity.
- * @return The new entity.
+ * @param location The location of the entity.
+ * @return The new entity, valid until the next entity is created or deleted.
  */
-Entity &Store::new_entity(energy_type energy, const Player::id_type &owner) {
-    auto entity = entity_factory.make(owner, energy);
-    return entities.emplace(entity.id, entity).first->second;
+Entity &Store::new_entity(energy_type energy, const Player::id_type &owner, Location location) {
+    auto &entity = entities.insert(entity_factory.make(owner, energy, location));
+    get_player(owner).add_entity(entity.id);
+    return entity;
 }
 
 /**
- * Delete an entity by ID.
+ * Delete an entity by ID, and take it from its owner.
  *
  * @param id The ID of the entity.
  */
 void Store::delete_entity(const Entity::id_type id) {
     //std::cout << "Deleted Entity: " << id << std::endl;
-    auto iterator = entities.find(id);
-    assert(iterator != entities.end());
-    entities.erase(iterator);
+    get_player(entities.at(id).owner).remove_entity(id);
+    entities.erase(id);
+}
+
+/**
+ * Record the energy an entity dropped off this turn, replacing any earlier record.
+ *
+ * @param id The ID of the entity.
+ * @param energy The energy dropped off.
+ */
+void Store::set_energy_dropped_off(const Entity::id_type &id, float energy) {
+    for (auto &[entity_id, dropped_off] : energy_dropped_off) {
+        if (entity_id == id) {
+            dropped_off = energy;
+            return;
+        }
+    }
+    energy_dropped_off.emplace_back(id, energy);
+}
+
+/**
+ * Get the energy an entity dropped off this turn.
+ *
+ * @param id The ID of the entity.
+ * @return The energy dropped off, or zero if there was none.
+ */
+float Store::get_energy_dropped_off(const Entity::id_type &id) const {
+    for (const auto &[entity_id, dropped_off] : energy_dropped_off) {
+        if (entity_id == id) {
+            return dropped_off;
+        }
+    }
+    return 0;
 }
 
 /**
@@ -72,4 +101,82 @@ Dropoff Store::new_dropoff(Location location) {
     return dropoff_factory.make(location);
 }
 
+/**
+ * Save the players, entities and ID counters to a snapshot, reusing its buffers.
+ * @param[out] snapshot The snapshot.
+ */
+void Store::save(GameSnapshot &snapshot) const {
+    snapshot.map_total_energy = map_total_energy;
+    snapshot.last_player_id = player_factory.last();
+    snapshot.last_entity_id = entity_factory.last();
+    snapshot.last_dropoff_id = dropoff_factory.last();
+
+    snapshot.entities.clear();
+    entities.for_each_in_id_order([&snapshot](const Entity &entity) {
+        snapshot.entities.push_back({entity.id.value, entity.owner.value, entity.energy, entity.location,
+                                     entity.was_captured, entity.is_inspired});
+    });
+    snapshot.players.clear();
+    snapshot.dropoffs.clear();
+    for (const auto &[player_id, player] : players) {
+        snapshot.players.push_back({player_id.value, player.energy, player.factory_energy_deposited,
+                                    player.total_energy_deposited, player.dropoffs.size(),
+                                    player.terminated, player.can_play});
+        for (const auto &dropoff : player.dropoffs) {
+            snapshot.dropoffs.push_back({dropoff.id.value, dropoff.location, dropoff.deposited_halite});
+        }
+    }
+    snapshot.self_collided.assign(selfCollidedEntities.begin(), selfCollidedEntities.end());
+    snapshot.dropped_off.clear();
+    for (const auto &[entity_id, energy] : energy_dropped_off) {
+        snapshot.dropped_off.push_back({entity_id.value, energy});
+    }
+}
+
+/**
+ * Restore the players, entities and ID counters from a snapshot of the same game.
+ * @param snapshot The snapshot.
+ */
+void Store::restore(const GameSnapshot &snapshot) {
+    // Players are never removed, so the same players are still here.
+    assert(snapshot.players.size() == players.size());
+    map_total_energy = snapshot.map_total_energy;
+    player_factory.resume_after(snapshot.last_player_id);
+    entity_factory.resume_after(snapshot.last_entity_id);
+    dropoff_factory.resume_after(snapshot.last_dropoff_id);
+
+    auto saved_dropoff = snapshot.dropoffs.begin();
+    for (const auto &saved : snapshot.players) {
+        auto &player = get_player(Player::id_type(saved.id));
+        player.energy = saved.energy;
+        player.factory_energy_deposited = saved.factory_energy_deposited;
+        player.total_energy_deposited = saved.total_energy_deposited;
+        player.terminated = saved.terminated;
+        player.can_play = saved.can_play;
+        player.entities.clear();
+        player.dropoffs.clear();
+        for (std::size_t index = 0; index < saved.dropoffs; index++, saved_dropoff++) {
+            auto &dropoff = player.dropoffs.emplace_back(Dropoff::id_type(saved_dropoff->id), saved_dropoff->location);
+            dropoff.deposited_halite = saved_dropoff->deposited_halite;
+        }
+    }
+
+    entities.reset();
+    for (const auto &saved : snapshot.entities) {
+        Entity entity(Entity::id_type(saved.id), player_id_type(saved.owner), saved.energy, saved.location);
+        entity.was_captured = saved.was_captured;
+        entity.is_inspired = saved.is_inspired;
+        // The entities come in ID order, so each owner's list stays sorted.
+        get_player(entity.owner).entities.push_back(entity.id);
+        entities.insert(entity);
+    }
+
+    selfCollidedEntities.assign(snapshot.self_collided.begin(), snapshot.self_collided.end());
+    energy_dropped_off.clear();
+    for (const auto &dropped_off : snapshot.dropped_off) {
+        energy_dropped_off.emplace_back(Entity::id_type(dropped_off.entity), dropped_off.energy);
+    }
+    changed_cells.clear();
+}
+
 }
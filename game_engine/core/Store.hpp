@@ -1,9 +1,11 @@
 #ifndef STORE_HPP
 #define STORE_HPP
 
-#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "Player.hpp"
+#include "SlotMap.hpp"
 
 namespace net {
 class Networking;
@@ -11,17 +13,19 @@ class Networking;
 
 namespace hlt {
 
+struct GameSnapshot;
+
 class Store;
 class StoreEntityIter {
     friend class Store;
-    id_map<Entity, Entity> &entities;
+    SlotMap<Entity> &entities;
 
-    StoreEntityIter(id_map<Entity, Entity> &entities) : entities{entities} {}
+    StoreEntityIter(SlotMap<Entity> &entities) : entities{entities} {}
 public:
-    id_map<Entity, Entity>::iterator begin() {
+    SlotMap<Entity>::iterator begin() {
         return entities.begin();
     }
-    id_map<Entity, Entity>::iterator end() {
+    SlotMap<Entity>::iterator end() {
         return entities.end();
     }
 };
@@ -37,14 +41,14 @@ class Store {
     Factory<Entity> entity_factory;   /**< The entity factory. */
     Factory<Dropoff> dropoff_factory; /**< The dropoff factory. */
 
-    std::unordered_set<Location> changed_cells{}; /**< The cells changed on the last turn. */
+    std::vector<Location> changed_cells{}; /**< The cells changed on the last turn, possibly repeated. */
 
 public:
-    id_map<Entity, Entity> entities;         /**< Map from entity ID to entity. */
+    SlotMap<Entity> entities;                /**< Map from entity ID to entity. */
     std::vector<long> selfCollidedEntities;  // Josh: List of entities that collided with their own ships on a given turn
     unsigned long long map_total_energy{}; /**< The total energy remaining on the map. */
     ordered_id_map<Player, Player> players;  /**< Map from player ID to player. */
-    id_map<Entity, float> energy_dropped_off;
+    std::vector<std::pair<Entity::id_type, float>> energy_dropped_off; /**< Energy dropped off per entity on the last turn. */
 
     /**
      * Get a player by ID.
@@ -76,13 +80,14 @@ public:
     StoreEntityIter all_entities() { return StoreEntityIter(entities); }
 
     /**
-     * Obtain a new entity.
+     * Obtain a new entity, and give it to its owner.
      *
      * @param energy The energy of the entity.
      * @param owner The owner of the entity.
-     * @return The new entity.
+     * @param location The location of the entity.
+     * @return The new entity, valid until the next entity is created or deleted.
      */
-    Entity &new_entity(energy_type energy, const Player::id_type &owner);
+    Entity &new_entity(energy_type energy, const Player::id_type &owner, Location location);
 
     /**
      * Obtain a new dropoff.
@@ -92,11 +97,39 @@ public:
     Dropoff new_dropoff(Location location);
 
     /**
-     * Delete an entity by ID.
+     * Delete an entity by ID, and take it from its owner.
      *
      * @param id The ID of the entity.
      */
     void delete_entity(Entity::id_type id);
+
+    /**
+     * Record the energy an entity dropped off this turn, replacing any earlier record.
+     *
+     * @param id The ID of the entity.
+     * @param energy The energy dropped off.
+     */
+    void set_energy_dropped_off(const Entity::id_type &id, float energy);
+
+    /**
+     * Get the energy an entity dropped off this turn.
+     *
+     * @param id The ID of the entity.
+     * @return The energy dropped off, or zero if there was none.
+     */
+    float get_energy_dropped_off(const Entity::id_type &id) const;
+
+    /**
+     * Save the players, entities and ID counters to a snapshot, reusing its buffers.
+     * @param[out] snapshot The snapshot.
+     */
+    void save(GameSnapshot &snapshot) const;
+
+    /**
+     * Restore the players, entities and ID counters from a snapshot of the same game.
+     * @param snapshot The snapshot.
+     */
+    void restore(const GameSnapshot &snapshot);
 };
 
 }
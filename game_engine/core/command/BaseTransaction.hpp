@@ -2,6 +2,7 @@
 #define BASETRANSACTION_HPP
 
 #include "CommandError.hpp"
+#include "GameConfig.hpp"
 #include "GameEvent.hpp"
 #include "Location.hpp"
 
@@ -25,8 +26,9 @@ private:
     callback<Location> cell_update_callback;          /**< Cell update callback. */
 
 protected:
-    Store &store; /**< The game store. */
-    Map &map;     /**< The game map. */
+    Store &store;              /**< The game store. */
+    Map &map;                  /**< The game map. */
+    const GameConfig &config;  /**< The game settings. */
 
     /**
      * Process a generated event.
@@ -46,7 +48,10 @@ protected:
      */
     template<class EventType, class... Args>
     void event_generated(Args &&...args) {
-        event_generated(std::make_unique<EventType>(std::forward<Args>(args)...));
+        // Events are only built when someone listens for them.
+        if (event_callback) {
+            event_generated(std::make_unique<EventType>(std::forward<Args>(args)...));
+        }
     }
 
     /**
@@ -92,11 +97,12 @@ protected:
 
 public:
     /**
-     * Construct BaseTransaction from Store and Map.
+     * Construct BaseTransaction from Store, Map and game settings.
      * @param store The Store.
      * @param map The Map.
+     * @param config The game settings.
      */
-    explicit BaseTransaction(Store &store, Map &map) : store(store), map(map) {}
+    BaseTransaction(Store &store, Map &map, const GameConfig &config) : store(store), map(map), config(config) {}
 
     /**
      * Set a callback for events generated during the transaction commit.
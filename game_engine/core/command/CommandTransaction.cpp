@@ -25,7 +25,7 @@ bool CommandTransaction::check_ownership(const Player &player, Entity::id_type e
     if (!player.has_entity(entity)) {
         std::cout << "Player: " << player.id.value << std::endl;
         for(auto currentEntity : player.entities) {
-            std::cout << "Our ship: " << currentEntity.first << "\t" << currentEntity.second << std::endl;
+            std::cout << "Our ship: " << currentEntity << "\t" << store.get_entity(currentEntity).location << std::endl;
         }
 
         std::cout << "Not our ship: " << entity << std::endl;
@@ -79,12 +79,11 @@ void CommandTransaction::add_expense(const Player &player, const Command &comman
 void CommandTransaction::add_command(Player &player, const ConstructCommand &command) {
     if (check_ownership(player, command.entity, command)) {
         add_occurrence(command.entity, command);
-        auto cost = Constants::get().DROPOFF_COST;
+        auto cost = config.DROPOFF_COST;
 
         // Cost factors in entity cargo and halite on target cell.
-        const auto location = player.get_entity_location(command.entity);
-        const auto &cell = map.at(location);
         const auto &entity = store.get_entity(command.entity);
+        const auto &cell = map.at(entity.location);
         if (cell.energy + entity.energy >= cost) {
             cost = 0;
         }
@@ -115,7 +114,7 @@ void CommandTransaction::add_command(Player &player, const MoveCommand &command)
  * @param command The command.
  */
 void CommandTransaction::add_command(Player &player, const SpawnCommand &command) {
-    add_expense(player, command, Constants::get().NEW_ENTITY_ENERGY_COST);
+    add_expense(player, command, config.NEW_ENTITY_ENERGY_COST);
     spawn_transaction.add_command(player, command);
 }
 
@@ -214,15 +213,16 @@ void CommandTransaction::on_cell_update(callback <Location> callback) {
 }
 
 /**
- * Construct CommandTransaction from Store and map.
+ * Construct CommandTransaction from Store, map and game settings.
  * @param store The Store.
  * @param map The Map.
+ * @param config The game settings.
  */
-CommandTransaction::CommandTransaction(Store &store, Map &map) :
-        BaseTransaction(store, map),
-        dump_transaction(store, map),
-        construct_transaction(store, map),
-        move_transaction(store, map),
-        spawn_transaction(store, map) {}
+CommandTransaction::CommandTransaction(Store &store, Map &map, const GameConfig &config, DestinationGrid &destinations) :
+        BaseTransaction(store, map, config),
+        dump_transaction(store, map, config),
+        construct_transaction(store, map, config),
+        move_transaction(store, map, config, destinations),
+        spawn_transaction(store, map, config) {}
 
 }
@@ -110,11 +110,13 @@ public:
     void on_cell_update(callback<Location> callback) override;
 
     /**
-     * Construct CommandTransaction from Store and map.
+     * Construct CommandTransaction from Store, map, game settings and scratch space.
      * @param store The Store.
      * @param map The Map.
+     * @param config The game settings.
+     * @param destinations The scratch space for resolving moves, reused every turn.
      */
-    explicit CommandTransaction(Store &store, Map &map);
+    CommandTransaction(Store &store, Map &map, const GameConfig &config, DestinationGrid &destinations);
 };
 
 }
@@ -0,0 +1,41 @@
+#include <cassert>
+
+#include "DestinationGrid.hpp"
+
+namespace hlt {
+
+/**
+ * Forget every destination, resizing to a map if needed.
+ * @param map The game map.
+ */
+void DestinationGrid::reset(const Map &map) {
+    const auto cells = static_cast<std::size_t>(map.width * map.height);
+    if (width != map.width || slots.size() != cells) {
+        width = map.width;
+        slots.assign(cells, -1);
+    } else {
+        for (const auto &destination : _destinations) {
+            slots[destination.location.y * width + destination.location.x] = -1;
+        }
+    }
+    _destinations.clear();
+}
+
+/**
+ * Add an entity headed to a cell.
+ * @param location The cell.
+ * @param entity The entity.
+ * @param command The command that moved it, or null if it was already there.
+ */
+void DestinationGrid::add(const Location &location, Entity::id_type entity, const MoveCommand *command) {
+    auto &slot = slots[location.y * width + location.x];
+    if (slot < 0) {
+        slot = static_cast<int32_t>(_destinations.size());
+        _destinations.emplace_back(location);
+    }
+    auto &destination = _destinations[slot];
+    assert(destination.count < MAX_ARRIVALS);
+    destination.arrivals[destination.count++] = {entity, command};
+}
+
+}
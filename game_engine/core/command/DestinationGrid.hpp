@@ -0,0 +1,75 @@
+#ifndef DESTINATIONGRID_HPP
+#define DESTINATIONGRID_HPP
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "Entity.hpp"
+#include "Map.hpp"
+
+namespace hlt {
+
+class MoveCommand;
+
+/**
+ * Scratch space for resolving the moves of one turn, kept by the game so that it is allocated once per map.
+ *
+ * Each cell of the map holds the index of its entry in a list of the destinations touched this turn, or -1. Each
+ * destination holds the entities headed there inline, so gathering the moves allocates nothing once the list has
+ * grown to the number of ships. Clearing only visits the cells in the list.
+ */
+class DestinationGrid {
+public:
+    /** The most entities that can end up on a cell: one from each neighbor, plus one that stayed. */
+    static constexpr std::size_t MAX_ARRIVALS = 5;
+
+    /** An entity headed to a destination. */
+    struct Arrival {
+        Entity::id_type entity;          /**< The entity. */
+        const MoveCommand *command;      /**< The command that moved it, or null if it was already there. */
+    };
+
+    /** A cell some entity is headed to. */
+    struct Destination {
+        Location location;                            /**< The cell. */
+        std::size_t count{};                          /**< The number of arrivals. */
+        std::array<Arrival, MAX_ARRIVALS> arrivals{}; /**< The arrivals, in the order they were added. */
+
+        /**
+         * Construct a Destination with no arrivals.
+         * @param location The cell.
+         */
+        explicit Destination(Location location) : location(location) {}
+    };
+
+private:
+    dimension_type width{};                 /**< The width of the map. */
+    std::vector<int32_t> slots;             /**< The index of each cell's destination, or -1. */
+    std::vector<Destination> _destinations; /**< The destinations touched this turn, in the order first touched. */
+
+public:
+    /** Scratch list of the entities of a collision, reused for every collision. */
+    std::vector<Entity::id_type> collision;
+
+    /**
+     * Forget every destination, resizing to a map if needed.
+     * @param map The game map.
+     */
+    void reset(const Map &map);
+
+    /**
+     * Add an entity headed to a cell.
+     * @param location The cell.
+     * @param entity The entity.
+     * @param command The command that moved it, or null if it was already there.
+     */
+    void add(const Location &location, Entity::id_type entity, const MoveCommand *command);
+
+    /** Get the destinations touched this turn, in the order first touched. */
+    std::vector<Destination> &destinations() { return _destinations; }
+};
+
+}
+
+#endif // DESTINATIONGRID_HPP
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <deque>
 
 #include "Transaction.hpp"
@@ -28,13 +29,13 @@ void dump_energy(Store &store, const Location &location, Cell &cell, energy_type
         player.total_energy_deposited += energy;
         if (location == player.factory) {
             player.factory_energy_deposited += energy;
-            store.energy_dropped_off[entity.id] = float(energy);
+            store.set_energy_dropped_off(entity.id, float(energy));
         }
         else {
             for (auto &dropoff : player.dropoffs) {
                 if (dropoff.location == location) {
                     dropoff.deposited_halite += energy;
-                    store.energy_dropped_off[entity.id] = float(energy);
+                    store.set_energy_dropped_off(entity.id, float(energy));
                     return;
                 }
             }
@@ -61,9 +62,8 @@ bool DumpTransaction::check() {
 void DumpTransaction::commit() {
     // If an entity ends the turn on their dropoff or shipyard,
     // auto-dump all their energy.
-    for (auto &[entity_id, entity] : store.all_entities()) {
-        const auto &player = store.get_player(entity.owner);
-        const auto &location = player.get_entity_location(entity.id);
+    for (auto &entity : store.all_entities()) {
+        const auto &location = entity.location;
         auto &cell = map.at(location);
         if (cell.owner == entity.owner) {
             dump_energy(store, entity, location, cell, entity.energy);
@@ -87,7 +87,7 @@ bool ConstructTransaction::check() {
                 error_generated<EntityNotFoundError<ConstructCommand>>(player_id, command);
                 success = false;
             } else {
-                const auto location = player.get_entity_location(command.entity);
+                const auto location = store.get_entity(command.entity).location;
                 const auto &cell = map.at(location);
                 if (cell.owner != Player::None) {
                     // Cell is already owned
@@ -102,13 +102,13 @@ bool ConstructTransaction::check() {
 
 /** If the transaction may be committed, commit the transaction. */
 void ConstructTransaction::commit() {
-    const auto cost = Constants::get().DROPOFF_COST;
+    const auto cost = config.DROPOFF_COST;
     for (auto &[player_id, constructs] : commands) {
         auto &player = store.get_player(player_id);
         for (const ConstructCommand &command : constructs) {
             const auto entity_id = command.entity;
             auto &entity = store.get_entity(entity_id);
-            const auto location = player.get_entity_location(entity_id);
+            const auto location = entity.location;
             auto &cell = map.at(location);
 
             // Mark as owned, clear contents of cell
@@ -129,7 +129,6 @@ void ConstructTransaction::commit() {
             // Charge player
             player.energy -= cost;
 
-            player.remove_entity(entity_id);
             store.delete_entity(entity_id);
         }
     }
@@ -156,111 +155,114 @@ bool MoveTransaction::check() {
 
 /** If the transaction may be committed, commit the transaction. */
 void MoveTransaction::commit() {
-    // Map from destination location to all the entities that want to go there.
-    std::unordered_map<Location, std::vector<Entity::id_type>> destinations;
-    /** Map from entity to the command that caused it to move. */
-    id_map<Entity, std::reference_wrapper<const MoveCommand>> causes;
+    // The destinations of this turn, each with all the entities that want to go there.
+    grid.reset(map);
     // Lift each entity that is moving from the grid.
     for (auto &[player_id, moves] : commands) {
-        auto &player = store.get_player(player_id);
         for (const MoveCommand &command : moves) {
             // If entity remained still, treat it as a no-op command.
             if (command.direction == Direction::Still) {
                 continue;
             }
-            auto location = player.get_entity_location(command.entity);
-            auto &source = map.at(location);
             auto &entity = store.get_entity(command.entity);
+            auto location = entity.location;
+            auto &source = map.at(location);
 
             // Check if entity has enough energy
             const auto cost = entity.is_inspired ?
-                Constants::get().INSPIRED_MOVE_COST_RATIO :
-                Constants::get().MOVE_COST_RATIO;
+                config.INSPIRED_MOVE_COST_RATIO :
+                config.MOVE_COST_RATIO;
             energy_type required = source.energy / cost;
 
             if (entity.energy < required) {
                 // Entity does not have enough energy, ignore command.
-                // error_generated<InsufficientEnergyError<MoveCommand>>(player_id, command, entity.energy, required, !Constants::get().STRICT_ERRORS);
+                // error_generated<InsufficientEnergyError<MoveCommand>>(player_id, command, entity.energy, required, !config.STRICT_ERRORS);
                 continue;
             }
-            causes.emplace(command.entity, command);
             // Decrease the entity's energy.
             entity.energy -= required;
             // Remove the entity from its source.
             source.entity = Entity::None;
             map.move_location(location, command.direction);
-            // Mark it as interested in the destination.
-            destinations[location].emplace_back(command.entity);
-            // Take it from its owner.
+            // Mark it as interested in the destination, along with the command that caused it to move.
             // Do not mark the entity as removed in the game yet.
-            store.get_player(entity.owner).remove_entity(command.entity);
+            grid.add(location, command.entity, &command);
         }
     }
+    auto &destinations = grid.destinations();
     // If there are already unmoving entities at the destination, lift them off too.
-    for (auto &[destination, _] : destinations) {
-        auto &cell = map.at(destination);
+    for (auto &destination : destinations) {
+        auto &cell = map.at(destination.location);
         if (cell.entity != Entity::None) {
-            destinations[destination].emplace_back(cell.entity);
-            store.get_player(store.get_entity(cell.entity).owner).remove_entity(cell.entity);
+            grid.add(destination.location, cell.entity, nullptr);
             cell.entity = Entity::None;
         }
     }
     // If only one entity is interested in a destination, place it there.
     // Otherwise, destroy all interested entities.
     static constexpr auto MAX_ENTITIES_PER_CELL = 1;
-    for (auto &[destination, entities] : destinations) {
-        auto &cell = map.at(destination);
-        if (entities.size() > MAX_ENTITIES_PER_CELL) {
+    for (auto &destination : destinations) {
+        const auto &location = destination.location;
+        const auto begin = destination.arrivals.begin();
+        const auto end = begin + destination.count;
+        auto &cell = map.at(location);
+        if (destination.count > MAX_ENTITIES_PER_CELL) {
             // Destroy all interested entities and collect them in replay info
-            std::vector<Entity::id_type> collision_ids;
-            id_map<Player, std::vector<Entity::id_type>> self_collisions;
-            id_map<Player, std::deque<std::reference_wrapper<const MoveCommand>>> self_collision_commands;
-            for (auto &entity_id : entities) {
-                auto &entity = store.get_entity(entity_id);
-                collision_ids.push_back(entity_id);
-                self_collisions[entity.owner].emplace_back(entity_id);
-                if (auto cause = causes.find(entity_id); cause != causes.end()) {
-                    self_collision_commands[entity.owner].emplace_back(cause->second);
-                }
+            auto &collision_ids = grid.collision;
+            collision_ids.clear();
+            for (auto arrival = begin; arrival != end; arrival++) {
+                collision_ids.push_back(arrival->entity);
+                store.selfCollidedEntities.push_back(arrival->entity.value);
                 // Don't delete entities/dump energy until after
                 // generating the event, so that HaliteImpl has a
                 // chance to collect statistics.
             }
 
-            for(auto id : collision_ids){
-                store.selfCollidedEntities.push_back(id.value);
-            }
-
-            for (const auto &[player_id, self_collision_entities] : self_collisions) {
-                if (self_collision_entities.size() > MAX_ENTITIES_PER_CELL) {
-                    auto &commands = self_collision_commands[player_id];
-                    const MoveCommand &first = commands.front();
-                    commands.pop_front();
-                    const ErrorContext context{commands.begin(), commands.end()};
-                    error_generated<SelfCollisionError<MoveCommand>>(player_id, first, context, destination,
-                                                                     self_collision_entities,
-                                                                     !Constants::get().STRICT_ERRORS);
+            // Report each player with several entities here, once, from its first entity.
+            for (auto arrival = begin; arrival != end; arrival++) {
+                const auto owner = store.get_entity(arrival->entity).owner;
+                const auto same_owner = [this, owner](const DestinationGrid::Arrival &other) {
+                    return store.get_entity(other.entity).owner == owner;
+                };
+                if (std::find_if(begin, arrival, same_owner) != arrival
+                    || std::count_if(arrival, end, same_owner) <= MAX_ENTITIES_PER_CELL) {
+                    continue;
                 }
+                std::vector<Entity::id_type> self_collision_entities;
+                std::deque<std::reference_wrapper<const MoveCommand>> self_collision_commands;
+                for (auto other = arrival; other != end; other++) {
+                    if (same_owner(*other)) {
+                        self_collision_entities.push_back(other->entity);
+                        if (other->command != nullptr) {
+                            self_collision_commands.emplace_back(*other->command);
+                        }
+                    }
+                }
+                const MoveCommand &first = self_collision_commands.front();
+                self_collision_commands.pop_front();
+                const ErrorContext context{self_collision_commands.begin(), self_collision_commands.end()};
+                error_generated<SelfCollisionError<MoveCommand>>(owner, first, context, location,
+                                                                 self_collision_entities,
+                                                                 !config.STRICT_ERRORS);
             }
 
             // When generating the event, HaliteImpl will record
             // statistics.
-            event_generated<CollisionEvent>(destination, collision_ids);
+            event_generated<CollisionEvent>(location, collision_ids);
             // Now we can delete the entities.
             for (const auto &entity_id : collision_ids) {
                 auto &entity = store.get_entity(entity_id);
                 // Dump the energy.
-                dump_energy(store, entity, destination, cell, entity.energy);
+                dump_energy(store, entity, location, cell, entity.energy);
                 store.delete_entity(entity_id);
             }
 
-            cell_updated(destination);
+            cell_updated(location);
         } else {
-            auto &entity_id = entities.front();
+            const auto entity_id = begin->entity;
             // Place it on the map.
             cell.entity = entity_id;
-            // Give it back to the owner.
-            store.get_player(store.get_entity(entity_id).owner).add_entity(entity_id, destination);
+            store.get_entity(entity_id).location = location;
             entity_updated(entity_id);
         }
     }
@@ -299,7 +301,7 @@ bool SpawnTransaction::check() {
 
 /** If the transaction may be committed, commit the transaction. */
 void SpawnTransaction::commit() {
-    const auto &constants = Constants::get();
+    const auto &constants = config;
     auto cost = constants.NEW_ENTITY_ENERGY_COST;
     for (const auto &[player_id, spawns] : commands) {
         for (const SpawnCommand &spawn : spawns) {
@@ -307,8 +309,7 @@ void SpawnTransaction::commit() {
             player.energy -= cost;
             auto &cell = map.at(player.factory);
             if (cell.entity == Entity::None) {
-                auto &entity = store.new_entity(0, player.id);
-                player.add_entity(entity.id, player.factory);
+                auto &entity = store.new_entity(0, player.id, player.factory);
                 cell.entity = entity.id;
                 entity_updated(entity.id);
                 event_generated<SpawnEvent>(player.factory, 0, player.id, entity.id);
@@ -321,14 +322,13 @@ void SpawnTransaction::commit() {
                 if (entity.owner == cell.owner) {
                     error_generated<SelfCollisionError<SpawnCommand>>(player_id, spawn, ErrorContext(), player.factory,
                                                                       std::vector<Entity::id_type>{cell.entity},
-                                                                      !Constants::get().STRICT_ERRORS);
+                                                                      !config.STRICT_ERRORS);
                 }
                 event_generated<CollisionEvent>(owner.factory, std::vector<Entity::id_type>{cell.entity});
 
                 // Use dump_energy in case the collision was from a
                 // different player.
                 dump_energy(store, entity, owner.factory, cell, entity.energy);
-                player.remove_entity(cell.entity);
                 store.delete_entity(cell.entity);
                 cell.entity = Entity::None;
             }
@@ -6,6 +6,7 @@
 #include <utility>
 
 #include "BaseTransaction.hpp"
+#include "DestinationGrid.hpp"
 #include "GameEvent.hpp"
 #include "Location.hpp"
 #include "Player.hpp"
@@ -79,8 +80,18 @@ public:
 
 /** Transaction for MoveCommand. */
 class MoveTransaction final : public Transaction<MoveCommand> {
+    DestinationGrid &grid; /**< Scratch space for the destinations of the moves. */
+
 public:
-    using Transaction::Transaction;
+    /**
+     * Construct MoveTransaction from Store, Map, game settings and scratch space.
+     * @param store The Store.
+     * @param map The Map.
+     * @param config The game settings.
+     * @param grid The scratch space for destinations, reused every turn.
+     */
+    MoveTransaction(Store &store, Map &map, const GameConfig &config, DestinationGrid &grid) :
+            Transaction(store, map, config), grid(grid) {}
 
     /**
      * Check if the transaction may be committed without actually committing.
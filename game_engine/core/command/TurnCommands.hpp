@@ -0,0 +1,90 @@
+#ifndef TURNCOMMANDS_HPP
+#define TURNCOMMANDS_HPP
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "span.hpp"
+
+namespace hlt {
+
+/** What a typed command does. The moves come first, in the order of the policy's action indices. */
+enum class AgentAction : uint8_t {
+    North,
+    East,
+    South,
+    West,
+    Still,
+    Spawn,
+    Construct,
+};
+
+/** A command without strings: the entity acting, or the player for a spawn, and its action. */
+struct TypedAgentCommand {
+    long entity;           /**< The entity ID, or the player ID for a spawn. */
+    AgentAction action;    /**< The action to take. */
+};
+
+/**
+ * The typed commands of every player for one turn.
+ *
+ * Each player's commands have their own buffer, read back as a span. Clearing keeps the memory of the buffers, so
+ * one instance is meant to be refilled every turn. It can only be moved, never copied, so a turn's commands are not
+ * duplicated on their way to the engine.
+ */
+class TurnCommands {
+    std::vector<std::vector<TypedAgentCommand>> buffers; /**< The commands of each player, by player ID. */
+
+public:
+    /** Construct TurnCommands for no players. */
+    TurnCommands() = default;
+
+    /**
+     * Construct TurnCommands with no commands.
+     * @param players The number of players taking part.
+     */
+    explicit TurnCommands(std::size_t players) : buffers(players) {}
+
+    TurnCommands(const TurnCommands &) = delete;
+    TurnCommands &operator=(const TurnCommands &) = delete;
+    TurnCommands(TurnCommands &&) = default;
+    TurnCommands &operator=(TurnCommands &&) = default;
+
+    /**
+     * Remove every command, keeping the memory of the buffers.
+     * @param players The number of players taking part; players with higher IDs are left out of the turn.
+     */
+    void clear(std::size_t players) {
+        buffers.resize(players);
+        for (auto &buffer : buffers) {
+            buffer.clear();
+        }
+    }
+
+    /**
+     * Add a command to the end of a player's commands.
+     * @param player The player ID, below players().
+     * @param command The command.
+     */
+    void add(long player, TypedAgentCommand command) {
+        assert(player >= 0 && static_cast<std::size_t>(player) < buffers.size());
+        buffers[player].push_back(command);
+    }
+
+    /** Get the number of players taking part, which is one more than the highest player ID. */
+    std::size_t players() const { return buffers.size(); }
+
+    /**
+     * Get the commands of a player.
+     * @param player The player ID, below players().
+     * @return The commands, in the order they were added.
+     */
+    Span<const TypedAgentCommand> of(std::size_t player) const {
+        return {buffers[player].data(), buffers[player].size()};
+    }
+};
+
+}
+
+#endif // TURNCOMMANDS_HPP
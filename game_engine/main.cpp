@@ -1,3 +1,4 @@
+#include <cstdint>
 #include <cstdlib>
 #include <fstream>
 #include <sstream>
@@ -13,6 +14,7 @@
 #include "Halite.hpp"
 #include "Replay.hpp"
 #include "Enumerated.hpp"
+#include "Profiler.hpp"
 
 //Torch
 #include <torch/torch.h>
@@ -21,9 +23,10 @@
 #include "../types.hpp"
 #include "../batcher.hpp"
 #include "../model.hpp"
+#include "../device.hpp"
 #include "agent.hpp"
 
-void ppo(Agent myAgent, uint numEpisodes, int iteration) {
+void ppo(Agent &myAgent, uint numEpisodes, int iteration) {
     auto bestMean = -1;
     auto bestNumSteps = -1;
     std::vector<double> allScores;
@@ -97,8 +100,8 @@ void ppo(Agent myAgent, uint numEpisodes, int iteration) {
                 torch::save(myAgent.myModel.fc1, std::to_string(iteration) + "fc1.pt");
                 torch::save(myAgent.myModel.fc2, std::to_string(iteration) + "fc2.pt");
                 torch::save(myAgent.myModel.fc3, std::to_string(iteration) + "fc3.pt");
-                //Now we move the model back to the GPU
-                myAgent.myModel.to(torch::kCUDA);
+                //Now we move the model back to the device it trains on
+                myAgent.myModel.to(myAgent.device);
             }
         }
     }
@@ -119,7 +122,8 @@ void ppo(Agent myAgent, uint numEpisodes, int iteration) {
     }
 }
 
-void loadWeights(Agent agent) {
+//Call before the agent's first step: the workers start then, and play the weights loaded here
+void loadWeights(Agent &agent) {
     try {
         agent.myModel.to(torch::kCPU);
         torch::load(agent.myModel.conv1, "0conv1.pt");
@@ -131,13 +135,12 @@ void loadWeights(Agent agent) {
     }
     catch (const std::exception& e) {
         std::cout << "Could not load models from disk. Starting from scratch" << std::endl;
-        agent.myModel.to(torch::kCUDA);
     }
 
-    agent.myModel.to(torch::kCUDA);
+    agent.myModel.place(agent.device);
 }
 
-void runGridSearch() {
+void runGridSearch(torch::Device device) {
   //Parameters over which we'd like to search
     std::vector<float> discount_rates {0.995};
     std::vector<int> learning_rounds {3, 5, 10};
@@ -149,6 +152,9 @@ void runGridSearch() {
     double ppo_clip = 0.2;              //
     int gradient_clip = 5;              //Clip gradient to try to prevent unstable learning
     float entropy_weight = 0.01;              //Clip gradient to try to prevent unstable learning
+    std::size_t num_workers = 4;        //Number of threads generating rollouts
+    std::size_t games_per_worker = 4;   //Number of games each rollout thread plays in lockstep
+    std::uint64_t master_seed = 1;      //Seeds the weights, the games and the sampling of every run
 
     int numProcessed = 0;
     for(auto discount_rate : discount_rates) {
@@ -167,7 +173,8 @@ void runGridSearch() {
 
                             int numEpisodes = 1000;
                             std::cout << "NumProccesed: " << numProcessed << std::endl;
-                            Agent agent(discount_rate, tau, learning_round, mini_batch_number, ppo_clip, minimum_rollout_size, learning_rate, entropy_weight);
+                            torch::manual_seed(master_seed);
+                            Agent agent(discount_rate, tau, learning_round, mini_batch_number, ppo_clip, minimum_rollout_size, learning_rate, entropy_weight, num_workers, games_per_worker, master_seed, device);
                             ppo(agent, numEpisodes, numProcessed);
                         }
                         catch (const std::exception& e) {
@@ -183,6 +190,11 @@ void runGridSearch() {
 }
 
 int main(int argc, char *argv[]) {
+    DeviceOptions deviceOptions;
+    if(!parseDeviceOptions(argc, argv, deviceOptions)) {
+        std::cerr << "Usage: " << argv[0] << " [--device=cpu|cuda|auto] [--intra-op-threads=N] [--inter-op-threads=N]" << std::endl;
+        return 1;
+    }
 
     int numEpisodes = 20000;
     int numProcessed = 0;
@@ -195,10 +207,24 @@ int main(int argc, char *argv[]) {
     float minimum_rollout_size = 5000;
     float learning_rate = 0.0000005;
     float entropy_weight = 0.01;
-
-    Agent agent(discount_rate, tau, learningRounds, mini_batch_number, ppo_clip, minimum_rollout_size, learning_rate, entropy_weight);
-    //loadWeights(agent);
-    ppo(agent, numEpisodes, numProcessed);
+    std::size_t num_workers = 4;
+    std::size_t games_per_worker = 4;
+    std::uint64_t master_seed = 1;
+
+    //The learner and every rollout worker run forward passes at once
+    shareIntraOpThreads(deviceOptions, num_workers + 1);
+    configureThreads(deviceOptions);
+    const auto device = selectDevice(deviceOptions);
+
+    //The initial weights come from torch's global generator; everything after that from the master seed
+    torch::manual_seed(master_seed);
+    {
+        Agent agent(discount_rate, tau, learningRounds, mini_batch_number, ppo_clip, minimum_rollout_size, learning_rate, entropy_weight, num_workers, games_per_worker, master_seed, device);
+        //loadWeights(agent);
+        ppo(agent, numEpisodes, numProcessed);
+    }
+    //The rollout workers have stopped with the agent, so their timings can be read
+    hlt::write_profile(std::cout);
 
 
     return 0;
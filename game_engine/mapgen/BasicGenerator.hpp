@@ -17,9 +17,10 @@ public:
     /**
      * Construct BasicGenerator from parameters.
      * @param parameters The map generation parameters.
+     * @param config The game settings.
      */
-    explicit BasicGenerator(const MapParameters &parameters) :
-            Generator(parameters), num_players(parameters.num_players) {}
+    BasicGenerator(const MapParameters &parameters, const GameConfig &config) :
+            Generator(parameters, config), num_players(parameters.num_players) {}
 };
 
 }
@@ -10,7 +10,7 @@ namespace mapgen {
 
 energy_type BlurTileGenerator::blur_function(dimension_type y_coord, dimension_type x_coord, const Map &map) const {
     // bring into local scope for shorter naming
-    const auto BLUR_FACTOR = Constants::get().BLUR_FACTOR;
+    const auto BLUR_FACTOR = config.BLUR_FACTOR;
     // Weight of a neighbor's effect on a cell's production value is dependent on the number of neighbors being considered
     // Declare as local constant as rest of function code is also implicitly dependent on the number of neighbors
     const auto NUM_NEIGHBORS = 4;
@@ -37,8 +37,8 @@ void BlurTileGenerator::generate(Map &map) {
     const auto max = static_cast<double>(std::mt19937::max());
 
     // Fetch max and min values for square production and store for ease of use
-    const auto MIN_CELL_PROD = Constants::get().MIN_CELL_PRODUCTION;
-    const auto MAX_CELL_PROD = Constants::get().MAX_CELL_PRODUCTION;
+    const auto MIN_CELL_PROD = config.MIN_CELL_PRODUCTION;
+    const auto MAX_CELL_PROD = config.MAX_CELL_PRODUCTION;
 
     for (dimension_type row = 0; row < tile_height; ++row) {
         for (dimension_type col = 0; col < tile_width; ++col) {
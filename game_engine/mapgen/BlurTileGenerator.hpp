@@ -35,9 +35,10 @@ public:
     /**
      * Construct BlurTileGenerator from parameters.
      * @param parameters: The map generation parameters.
+     * @param config: The game settings.
      */
-    explicit BlurTileGenerator(const MapParameters &parameters) :
-            TileGenerator(parameters) {};
+    BlurTileGenerator(const MapParameters &parameters, const GameConfig &config) :
+            TileGenerator(parameters, config) {};
 };
 }
 }
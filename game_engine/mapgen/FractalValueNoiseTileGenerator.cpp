@@ -42,9 +42,9 @@ void FractalValueNoiseTileGenerator::generate(Map &map) {
     std::vector<std::vector<double> > source_noise(tile_height, std::vector<double>(tile_width, 0));
     std::vector<std::vector<double> > region = source_noise;
 
-    const auto FACTOR_EXP_1 = Constants::get().FACTOR_EXP_1;
-    const auto FACTOR_EXP_2 = Constants::get().FACTOR_EXP_2;
-    const auto PERSISTENCE = Constants::get().PERSISTENCE;
+    const auto FACTOR_EXP_1 = config.FACTOR_EXP_1;
+    const auto FACTOR_EXP_2 = config.FACTOR_EXP_2;
+    const auto PERSISTENCE = config.PERSISTENCE;
 
     std::uniform_real_distribution<double> urd(0.0, 1.0);
     for (dimension_type y = 0; y < tile_height; y++) {
@@ -81,8 +81,8 @@ void FractalValueNoiseTileGenerator::generate(Map &map) {
 
     // Normalize to highest value
     const energy_type MAX_CELL_PRODUCTION =
-            rng() % (1 + Constants::get().MAX_CELL_PRODUCTION - Constants::get().MIN_CELL_PRODUCTION) +
-            Constants::get().MIN_CELL_PRODUCTION;
+            rng() % (1 + config.MAX_CELL_PRODUCTION - config.MIN_CELL_PRODUCTION) +
+            config.MIN_CELL_PRODUCTION;
     for (dimension_type y = 0; y < tile_height; y++) {
         for (dimension_type x = 0; x < tile_width; x++) {
             region[y][x] *= MAX_CELL_PRODUCTION / max_value;
@@ -30,9 +30,10 @@ public:
     /**
      * Construct BlurTileGenerator from parameters.
      * @param parameters: The map generation parameters.
+     * @param config: The game settings.
      */
-    explicit FractalValueNoiseTileGenerator(const MapParameters &parameters) :
-            SymmetricalTile(parameters) {};
+    FractalValueNoiseTileGenerator(const MapParameters &parameters, const GameConfig &config) :
+            SymmetricalTile(parameters, config) {};
 };
 }
 }
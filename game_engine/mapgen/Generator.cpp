@@ -9,17 +9,18 @@ namespace mapgen {
  * Generate a map based on parameters.
  * @param[out] map The map to generate.
  * @param parameters The parameters to use.
+ * @param config The game settings.
  */
-void Generator::generate(Map &map, const MapParameters &parameters) {
+void Generator::generate(Map &map, const MapParameters &parameters, const GameConfig &config) {
     switch (parameters.type) {
     case MapType::Basic:
-        BasicGenerator(parameters).generate(map);
+        BasicGenerator(parameters, config).generate(map);
         break;
     case MapType::BlurTile:
-        BlurTileGenerator(parameters).generate(map);
+        BlurTileGenerator(parameters, config).generate(map);
         break;
     case MapType::Fractal:
-        FractalValueNoiseTileGenerator(parameters).generate(map);
+        FractalValueNoiseTileGenerator(parameters, config).generate(map);
         break;
     }
 }
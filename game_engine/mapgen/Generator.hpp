@@ -3,6 +3,7 @@
 
 #include <random>
 
+#include "Constants.hpp"
 #include "Map.hpp"
 
 namespace hlt {
@@ -39,11 +40,15 @@ protected:
     /** The random number generator. */
     std::mt19937 rng;
 
+    /** The settings of the game the map is generated for. */
+    const GameConfig &config;
+
     /**
      * Construct Generator from parameters.
      * @param parameters The map generation parameters.
+     * @param config The game settings.
      */
-    explicit Generator(const MapParameters &parameters) : rng(parameters.seed) {}
+    Generator(const MapParameters &parameters, const GameConfig &config) : rng(parameters.seed), config(config) {}
 
 public:
     /**  Get the name of this map generator. */
@@ -59,8 +64,9 @@ public:
      * Generate a map based on parameters.
      * @param[out] map The map to generate.
      * @param parameters The parameters to use.
+     * @param config The game settings, by default the global constants.
      */
-    static void generate(Map &map, const MapParameters &parameters);
+    static void generate(Map &map, const MapParameters &parameters, const GameConfig &config = Constants::get());
 };
 
 }
@@ -10,9 +10,10 @@ namespace mapgen {
  * @param parameters: Map parameters as defined in Generator.hpp
  * Note: dynamically calculates tile height and width based on overall height and width and
  * number of players. Will cause an assertion error if map for number of players cannot be created via repeated reflection
+ * @param config: The game settings
  */
-SymmetricalTile::SymmetricalTile(const MapParameters &parameters) :
-        Generator(parameters),
+SymmetricalTile::SymmetricalTile(const MapParameters &parameters, const GameConfig &config) :
+        Generator(parameters, config),
         width(parameters.width),
         height(parameters.height),
         num_players(parameters.num_players) {
@@ -60,8 +60,9 @@ public:
      * @param parameters: Map parameters as defined in Generator.hpp
      * Note: dynamically calculates tile height and width based on overall height and width and
      * number of players. Will cause an assertion error if map for number of players cannot be created via repeated reflection
+     * @param config: The game settings
      */
-    explicit SymmetricalTile(const MapParameters &parameters);
+    SymmetricalTile(const MapParameters &parameters, const GameConfig &config);
 
 };
 }
@@ -27,8 +27,8 @@ void TileGenerator::tile_map(Map &map, const dimension_type factory_y, const dim
     }
 }
 
-TileGenerator::TileGenerator(const MapParameters &parameters) :
-        Generator(parameters),
+TileGenerator::TileGenerator(const MapParameters &parameters, const GameConfig &config) :
+        Generator(parameters, config),
         width(parameters.width),
         height(parameters.height),
         num_players(parameters.num_players) {
@@ -46,8 +46,9 @@ public:
      * Note: dynamically calculates tile height and width based on  overall height and width and
      * number of players. Will cause an assertion error if given height and width cannot be divided into tiles
      * evenly (ie equally sized tiles arranged in a nice grid)
+     * @param config: The game settings
      */
-    explicit TileGenerator(const MapParameters &parameters);
+    TileGenerator(const MapParameters &parameters, const GameConfig &config);
 
 };
 }
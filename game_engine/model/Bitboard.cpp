@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <cassert>
+
+#include "Bitboard.hpp"
+
+namespace hlt {
+
+/**
+ * Construct an empty bitboard.
+ * @param width The width of the map, at most MAX_WIDTH.
+ * @param height The height of the map.
+ */
+Bitboard::Bitboard(dimension_type width, dimension_type height) {
+    resize(width, height);
+}
+
+/**
+ * Resize to a map, emptying the set. No memory is allocated if the size does not change.
+ * @param width The width of the map, at most MAX_WIDTH.
+ * @param height The height of the map.
+ */
+void Bitboard::resize(dimension_type width, dimension_type height) {
+    assert(supports(width) && height > 0);
+    _width = width;
+    _height = height;
+    mask = width == MAX_WIDTH ? ~row_type{0} : (row_type{1} << width) - 1;
+    rows.assign(static_cast<std::size_t>(height), 0);
+}
+
+/** Remove every cell. */
+void Bitboard::clear() {
+    std::fill(rows.begin(), rows.end(), 0);
+}
+
+/** Determine whether any cell is in the set. */
+bool Bitboard::any() const {
+    for (const auto bits : rows) {
+        if (bits != 0) return true;
+    }
+    return false;
+}
+
+/** Get the number of cells in the set. */
+long Bitboard::count() const {
+    long total = 0;
+    for (const auto bits : rows) {
+        total += __builtin_popcountll(bits);
+    }
+    return total;
+}
+
+/**
+ * Add every cell of another bitboard of the same size.
+ * @param other The other bitboard.
+ * @return This bitboard.
+ */
+Bitboard &Bitboard::operator|=(const Bitboard &other) {
+    assert(other._width == _width && other._height == _height);
+    for (std::size_t y = 0; y < rows.size(); y++) {
+        rows[y] |= other.rows[y];
+    }
+    return *this;
+}
+
+/**
+ * Keep only the cells also in another bitboard of the same size.
+ * @param other The other bitboard.
+ * @return This bitboard.
+ */
+Bitboard &Bitboard::operator&=(const Bitboard &other) {
+    assert(other._width == _width && other._height == _height);
+    for (std::size_t y = 0; y < rows.size(); y++) {
+        rows[y] &= other.rows[y];
+    }
+    return *this;
+}
+
+/**
+ * Move every cell by an offset, wrapping around the edges of the map.
+ * @param dx The columns to move by; positive is east.
+ * @param dy The rows to move by; positive is south.
+ * @param[out] out The moved set, resized to this map.
+ */
+void Bitboard::shift(dimension_type dx, dimension_type dy, Bitboard &out) const {
+    assert(&out != this);
+    if (out._width != _width || out._height != _height) {
+        out.resize(_width, _height);
+    }
+    const auto columns = ((dx % _width) + _width) % _width;
+    const auto first_row = ((dy % _height) + _height) % _height;
+    for (dimension_type y = 0; y < _height; y++) {
+        auto target = y + first_row;
+        if (target >= _height) {
+            target -= _height;
+        }
+        out.rows[target] = rotate_east(rows[y], columns);
+    }
+}
+
+/**
+ * Grow the set in place to every cell within a Manhattan distance of one of its cells, wrapping around the
+ * edges of the map. Each step of the radius adds the four neighbors of every cell.
+ * @param radius The distance.
+ */
+void Bitboard::expand(dimension_type radius) {
+    if (rows.empty()) return;
+    const auto last = rows.size() - 1;
+    for (dimension_type step = 0; step < radius; step++) {
+        // Rows are overwritten top to bottom, so keep the original words of the row above and of the first row.
+        const auto first = rows.front();
+        auto above = rows.back();
+        for (std::size_t y = 0; y <= last; y++) {
+            const auto current = rows[y];
+            const auto below = y < last ? rows[y + 1] : first;
+            rows[y] = current | rotate_east(current, 1) | rotate_west(current, 1) | above | below;
+            above = current;
+        }
+    }
+}
+
+/**
+ * Write the set as a row-major plane of floats, one per cell.
+ * @param plane The plane, width * height floats.
+ * @param value The value of cells in the set; other cells are 0.
+ */
+void Bitboard::write_plane(float *plane, float value) const {
+    write_plane(rows.data(), _width, _height, plane, value);
+}
+
+/**
+ * Write rows stored apart from a bitboard, such as copies of row(), as a row-major plane of floats.
+ * @param rows The words of the rows, top to bottom.
+ * @param width The width of the map, at most MAX_WIDTH.
+ * @param height The height of the map.
+ * @param plane The plane, width * height floats.
+ * @param value The value of cells in the set; other cells are 0.
+ */
+void Bitboard::write_plane(const row_type *rows, dimension_type width, dimension_type height, float *plane,
+                           float value) {
+    for (dimension_type y = 0; y < height; y++) {
+        const auto bits = rows[y];
+        for (dimension_type x = 0; x < width; x++) {
+            *plane++ = ((bits >> x) & 1) ? value : 0.0f;
+        }
+    }
+}
+
+}
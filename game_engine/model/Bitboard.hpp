@@ -0,0 +1,169 @@
+#ifndef BITBOARD_HPP
+#define BITBOARD_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "Location.hpp"
+#include "Units.hpp"
+
+namespace hlt {
+
+/**
+ * A set of cells of a map at most 64 cells wide, stored as one 64-bit word per row.
+ *
+ * Bit x of row y stands for cell (x, y). Moving the set around the torus is a rotation of each word within the
+ * width of the map, or a rotation of the rows, so a whole neighborhood query costs a few word operations per row.
+ */
+class Bitboard {
+public:
+    using row_type = uint64_t;
+
+    /** The widest map a bitboard can represent. */
+    static constexpr dimension_type MAX_WIDTH = 64;
+
+private:
+    dimension_type _width{};        /**< The width of the map. */
+    dimension_type _height{};       /**< The height of the map. */
+    row_type mask{};                /**< The bits of a row that stand for cells. */
+    std::vector<row_type> rows;     /**< The words of the rows, top to bottom. */
+
+public:
+    /**
+     * Determine whether maps of a width can be represented.
+     * @param width The width of the map.
+     * @return True if the map is narrow enough.
+     */
+    static bool supports(dimension_type width) { return width > 0 && width <= MAX_WIDTH; }
+
+    /** Construct an empty bitboard of no cells. */
+    Bitboard() = default;
+
+    /**
+     * Construct an empty bitboard.
+     * @param width The width of the map, at most MAX_WIDTH.
+     * @param height The height of the map.
+     */
+    Bitboard(dimension_type width, dimension_type height);
+
+    /**
+     * Resize to a map, emptying the set. No memory is allocated if the size does not change.
+     * @param width The width of the map, at most MAX_WIDTH.
+     * @param height The height of the map.
+     */
+    void resize(dimension_type width, dimension_type height);
+
+    /** Get the width of the map. */
+    dimension_type width() const { return _width; }
+
+    /** Get the height of the map. */
+    dimension_type height() const { return _height; }
+
+    /**
+     * Get the word of a row.
+     * @param y The row.
+     * @return The word, with bit x set for each cell (x, y) in the set.
+     */
+    row_type row(dimension_type y) const { return rows[y]; }
+
+    /** Remove every cell. */
+    void clear();
+
+    /**
+     * Add a cell.
+     * @param location The cell.
+     */
+    void set(const Location &location) { rows[location.y] |= row_type{1} << location.x; }
+
+    /**
+     * Remove a cell.
+     * @param location The cell.
+     */
+    void reset(const Location &location) { rows[location.y] &= ~(row_type{1} << location.x); }
+
+    /**
+     * Determine whether a cell is in the set.
+     * @param location The cell.
+     * @return True if the cell is in the set.
+     */
+    bool test(const Location &location) const { return (rows[location.y] >> location.x) & 1; }
+
+    /** Determine whether any cell is in the set. */
+    bool any() const;
+
+    /** Get the number of cells in the set. */
+    long count() const;
+
+    /**
+     * Add every cell of another bitboard of the same size.
+     * @param other The other bitboard.
+     * @return This bitboard.
+     */
+    Bitboard &operator|=(const Bitboard &other);
+
+    /**
+     * Keep only the cells also in another bitboard of the same size.
+     * @param other The other bitboard.
+     * @return This bitboard.
+     */
+    Bitboard &operator&=(const Bitboard &other);
+
+    /**
+     * Rotate a row toward higher x, wrapping cells past the right edge around to the left.
+     * @param bits The word of the row.
+     * @param columns The number of columns to move by, in [0, width].
+     * @return The rotated word.
+     */
+    row_type rotate_east(row_type bits, dimension_type columns) const {
+        if (columns == 0 || columns == _width) return bits;
+        return ((bits << columns) | (bits >> (_width - columns))) & mask;
+    }
+
+    /**
+     * Rotate a row toward lower x, wrapping cells past the left edge around to the right.
+     * @param bits The word of the row.
+     * @param columns The number of columns to move by, in [0, width].
+     * @return The rotated word.
+     */
+    row_type rotate_west(row_type bits, dimension_type columns) const {
+        if (columns == 0 || columns == _width) return bits;
+        return ((bits >> columns) | (bits << (_width - columns))) & mask;
+    }
+
+    /**
+     * Move every cell by an offset, wrapping around the edges of the map.
+     * @param dx The columns to move by; positive is east.
+     * @param dy The rows to move by; positive is south.
+     * @param[out] out The moved set, resized to this map.
+     */
+    void shift(dimension_type dx, dimension_type dy, Bitboard &out) const;
+
+    /**
+     * Grow the set in place to every cell within a Manhattan distance of one of its cells, wrapping around the
+     * edges of the map. Each step of the radius adds the four neighbors of every cell.
+     * @param radius The distance.
+     */
+    void expand(dimension_type radius);
+
+    /**
+     * Write the set as a row-major plane of floats, one per cell.
+     * @param plane The plane, width * height floats.
+     * @param value The value of cells in the set; other cells are 0.
+     */
+    void write_plane(float *plane, float value = 1.0f) const;
+
+    /**
+     * Write rows stored apart from a bitboard, such as copies of row(), as a row-major plane of floats.
+     * @param rows The words of the rows, top to bottom.
+     * @param width The width of the map, at most MAX_WIDTH.
+     * @param height The height of the map.
+     * @param plane The plane, width * height floats.
+     * @param value The value of cells in the set; other cells are 0.
+     */
+    static void write_plane(const row_type *rows, dimension_type width, dimension_type height, float *plane,
+                            float value = 1.0f);
+};
+
+}
+
+#endif // BITBOARD_HPP
@@ -3,6 +3,7 @@
 
 #include "Constants.hpp"
 #include "Enumerated.hpp"
+#include "Location.hpp"
 
 namespace hlt {
 
@@ -11,12 +12,16 @@ struct Player;
 
 using player_id_type = class_id<Player>;
 
+class Store;
+
 /** A player-affiliated entity placed on the Halite map. */
 struct Entity final : public Enumerated<Entity> {
     friend class Factory<Entity>;
+    friend class Store; // Recreates entities with their own IDs when a saved game is restored.
 
-    const player_id_type owner; /**< Owner of the entity. */
+    player_id_type owner;       /**< Owner of the entity. */
     energy_type energy;         /**< Energy of the entity. */
+    Location location;          /**< Location of the entity on the map. */
     bool was_captured;          /**< Track whether this entity was captured for statistics purposes. */
     bool is_inspired;           /**< Track whether or not this entity is currently inspired. */
 
@@ -31,12 +36,14 @@ struct Entity final : public Enumerated<Entity> {
 
 private:
     /**
-     * Create Entity from ID, owner ID, and energy.
+     * Create Entity from ID, owner ID, energy, and location.
      * @param id The entity ID.
      * @param owner The owner ID.
      * @param energy The energy.
+     * @param location The location.
      */
-    Entity(id_type id, player_id_type owner, energy_type energy) : Enumerated(id), owner(owner), energy(energy), was_captured(false), is_inspired(false) {}
+    Entity(id_type id, player_id_type owner, energy_type energy, Location location) :
+            Enumerated(id), owner(owner), energy(energy), location(location), was_captured(false), is_inspired(false) {}
 };
 
 }
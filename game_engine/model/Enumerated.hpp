@@ -142,6 +142,15 @@ public:
     T make(Args &&...args) {
         return T(class_id<T>(++last_id), std::forward<Args>(args)...);
     }
+
+    /** Get the last ID allocated, or the sentinel if there is none. */
+    id_value_type last() const { return last_id; }
+
+    /**
+     * Continue allocating after an ID, as when a saved game is restored.
+     * @param id The last ID allocated.
+     */
+    void resume_after(id_value_type id) { last_id = id; }
 };
 
 #endif // ENUMERATED_HPP
@@ -2,42 +2,77 @@
 #define GRID_HPP
 
 #include <cassert>
+#include <vector>
 
 #include "Location.hpp"
+#include "span.hpp"
 
 namespace hlt {
 
 /**
  * Template for classes representing grids indexable along two dimensions.
+ *
+ * Entries are kept in a single row-major buffer. Rows start every `stride` entries, which is either the width
+ * of the grid or, for padded grids, the width rounded up to a power of two.
+ *
  * @tparam Entry The type of entries in the grid.
  */
 template<class Entry>
 class Grid {
 public:
     /** The type of the grid. */
-    using grid_type = std::vector<std::vector<Entry>>;
+    using grid_type = std::vector<Entry>;
+
+    /** The type of indices into the grid storage. */
+    using size_type = typename grid_type::size_type;
 
     dimension_type width{};   /**< The width of the grid. */
     dimension_type height{};  /**< The height of the grid. */
+    dimension_type stride{};  /**< The distance in entries between the starts of consecutive rows. */
 
     /** The internal data storage. */
     grid_type grid;
 
+    /**
+     * Get the smallest power of two that can hold a row of a given width.
+     * @param width The width.
+     * @return The padded stride.
+     */
+    static constexpr dimension_type padded_stride(dimension_type width) {
+        dimension_type stride = 1;
+        while (stride < width) {
+            stride <<= 1;
+        }
+        return stride;
+    }
+
     /**
      * Create a Grid from dimensions.
      * @param width The width.
      * @param height The height.
+     * @param padded Whether to pad rows out to a power-of-two stride.
      */
-    Grid(dimension_type width, dimension_type height) : width(width), height(height) {
-        grid.resize(static_cast<typename grid_type::size_type>(height));
-        for (auto &row : grid) {
-            row.resize(static_cast<typename std::remove_reference_t<decltype(row)>::size_type>(width));
-        }
+    Grid(dimension_type width, dimension_type height, bool padded = false) :
+            width(width), height(height), stride(padded ? padded_stride(width) : width) {
+        grid.resize(static_cast<size_type>(stride * height));
     }
 
     /** Default constructor. */
     Grid() = default;
 
+    /**
+     * Get the storage index of grid coordinates.
+     * @param x The grid x-coordinate.
+     * @param y The grid y-coordinate.
+     * @return The index of (x, y) in the storage.
+     */
+    size_type index(dimension_type x, dimension_type y) const {
+        // Rows are laid out one after another, so the memory representation
+        // is consistent with the physical grid, indexed by rows then columns.
+        assert(0 <= y && y < height && 0 <= x && x < width);
+        return static_cast<size_type>(y * stride + x);
+    }
+
     /**
      * Get a reference to an entry at grid coordinates.
      * @param x The grid x-coordinate.
@@ -45,10 +80,7 @@ public:
      * @return Reference to the entry at (x, y).
      */
     Entry &at(dimension_type x, dimension_type y) {
-        // Flipping x and y gives us a grid memory representation that is consistent
-        // with the physical grid, indexed by rows then columns.
-        assert(0 <= y && y <= height && 0 <= x && x <= width);
-        return grid[y][x];
+        return grid[index(x, y)];
     }
 
     /**
@@ -58,8 +90,7 @@ public:
      * @return Reference to the entry at (x, y).
      */
     const Entry &at(dimension_type x, dimension_type y) const {
-        assert(0 <= y && y <= height && 0 <= x && x <= width);
-        return grid[y][x];
+        return grid[index(x, y)];
     }
 
     /**
@@ -68,9 +99,7 @@ public:
      * @return Reference to the entry at (x, y).
      */
     Entry &at(const Location &location) {
-        auto [x, y] = location;
-        assert(0 <= y && y <= height && 0 <= x && x <= width);
-        return grid[y][x];
+        return grid[index(location.x, location.y)];
     }
 
     /**
@@ -79,9 +108,7 @@ public:
      * @return Reference to the entry at (x, y).
      */
     const Entry &at(const Location &location) const {
-        auto [x, y] = location;
-        assert(0 <= y && y <= height && 0 <= x && x <= width);
-        return grid[y][x];
+        return grid[index(location.x, location.y)];
     }
 
     /**
@@ -102,6 +129,42 @@ public:
         return at(location);
     }
 
+    /**
+     * Get a pointer to the first entry of a row. The row's entries are contiguous.
+     * @param y The grid y-coordinate of the row.
+     * @return Pointer to the entry at (0, y).
+     */
+    Entry *row(dimension_type y) {
+        return grid.data() + index(0, y);
+    }
+
+    /**
+     * Get a const pointer to the first entry of a row. The row's entries are contiguous.
+     * @param y The grid y-coordinate of the row.
+     * @return Pointer to the entry at (0, y).
+     */
+    const Entry *row(dimension_type y) const {
+        return grid.data() + index(0, y);
+    }
+
+    /**
+     * Get a view over the entries of a row.
+     * @param y The grid y-coordinate of the row.
+     * @return The width entries of row y.
+     */
+    Span<Entry> row_span(dimension_type y) {
+        return {row(y), static_cast<std::size_t>(width)};
+    }
+
+    /**
+     * Get a read-only view over the entries of a row.
+     * @param y The grid y-coordinate of the row.
+     * @return The width entries of row y.
+     */
+    Span<const Entry> row_span(dimension_type y) const {
+        return {row(y), static_cast<std::size_t>(width)};
+    }
+
     /** Virtual destructor. */
     virtual ~Grid() = default;
 };
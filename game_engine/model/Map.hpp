@@ -60,8 +60,9 @@ public:
      * Create a Map from dimensions.
      * @param width The width.
      * @param height The height.
+     * @param padded Whether to pad rows out to a power-of-two stride.
      */
-    Map(dimension_type width, dimension_type height) : Grid(width, height) {}
+    Map(dimension_type width, dimension_type height, bool padded = false) : Grid(width, height, padded) {}
 };
 
 }
@@ -1,4 +1,4 @@
-#include <set>
+#include <algorithm>
 
 #include "Entity.hpp"
 #include "Player.hpp"
@@ -22,24 +22,13 @@ std::ostream &operator<<(std::ostream &ostream, const Player &player) {
     return ostream;
 }
 
-/**
- * Get the location of an entity.
- * @param id The entity ID.
- * @return The entity location.
- */
-Location Player::get_entity_location(const Entity::id_type &id) const {
-    auto iterator = entities.find(id);
-    assert(iterator != entities.end());
-    return iterator->second;
-}
-
 /**
  * Get whether the player has an entity.
  * @param id The entity ID.
  * @return True if the player has the entity, false otherwise.
  */
 bool Player::has_entity(const Entity::id_type &id) const {
-    return entities.find(id) != entities.end();
+    return std::binary_search(entities.begin(), entities.end(), id);
 }
 
 /**
@@ -47,19 +36,19 @@ bool Player::has_entity(const Entity::id_type &id) const {
  * @param id The entity ID.
  */
 void Player::remove_entity(const Entity::id_type &id) {
-    auto iterator = entities.find(id);
-    assert(iterator != entities.end());
+    auto iterator = std::lower_bound(entities.begin(), entities.end(), id);
+    assert(iterator != entities.end() && *iterator == id);
     entities.erase(iterator);
 }
 
 /**
  * Add an entity by ID.
  * @param id The entity ID to add.
- * @param location The location of the entity.
  */
-void Player::add_entity(const Entity::id_type &id, Location location) {
-    assert(!has_entity(id));
-    entities.emplace(id, location);
+void Player::add_entity(const Entity::id_type &id) {
+    auto iterator = std::lower_bound(entities.begin(), entities.end(), id);
+    assert(iterator == entities.end() || *iterator != id);
+    entities.insert(iterator, id);
 }
 
 }
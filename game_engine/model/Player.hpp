@@ -2,8 +2,8 @@
 #define PLAYER_H
 
 #include <string>
-#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "Dropoff.hpp"
 #include "Entity.hpp"
@@ -23,7 +23,7 @@ struct Player final : public Enumerated<Player> {
     energy_type factory_energy_deposited{}; /**< The amount of energy deposited at the factory so far. */
     energy_type total_energy_deposited{}; /**< The amount of energy collected so far. */
     //const std::string command;           /**< The bot command for the player. */
-    id_map<Entity, Location> entities{}; /**< Mapping from entity to location. */
+    std::vector<Entity::id_type> entities{}; /**< The entities owned by the player, in ID order. */
     bool terminated;                     /**< Whether the player was kicked out of the game. */
     bool can_play = true;                /**< Whether the player has sufficient resources remaining. */
 
@@ -37,9 +37,8 @@ struct Player final : public Enumerated<Player> {
     /**
      * Add an entity by ID.
      * @param id The entity ID to add.
-     * @param location The location of the entity.
      */
-    void add_entity(const Entity::id_type &id, Location location);
+    void add_entity(const Entity::id_type &id);
 
     /**
      * Remove an entity by ID.
@@ -47,13 +46,6 @@ struct Player final : public Enumerated<Player> {
      */
     void remove_entity(const Entity::id_type &id);
 
-    /**
-     * Get the location of an entity.
-     * @param id The entity ID.
-     * @return The entity location.
-     */
-    Location get_entity_location(const Entity::id_type &id) const;
-
     /**
      * Write a Player to bot serial format.
      * @param ostream The output stream.
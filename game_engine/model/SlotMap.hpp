@@ -0,0 +1,225 @@
+#ifndef SLOTMAP_HPP
+#define SLOTMAP_HPP
+
+#include <cassert>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "Enumerated.hpp"
+
+/**
+ * Dense storage for Enumerated objects, indexed by ID without hashing.
+ *
+ * Live objects are packed in a dense array; removing one moves the last object into its place, so insertion,
+ * removal and lookup are all constant time, and iteration visits the objects in no particular order.
+ *
+ * IDs come from a Factory, so they increase monotonically and are never reused: an ID is its own generation
+ * counter, and a stale ID is detected by its slot being empty. The slot table covers only the window of IDs from
+ * the oldest live object to the newest, and drops its dead front once that makes up half of it, so its size is
+ * bounded by the span of live IDs rather than by every ID ever issued. Visiting objects in ID order walks this
+ * window instead, for the callers that depend on that order.
+ *
+ * @tparam T The stored class, which must expose an id member of type T::id_type.
+ */
+template<class T>
+class SlotMap {
+public:
+    using id_type = typename T::id_type;                          /**< The ID type of stored objects. */
+    using storage_type = std::vector<T>;                          /**< The type of the dense storage. */
+    using size_type = typename storage_type::size_type;           /**< The type of dense indices. */
+    using iterator = typename storage_type::iterator;             /**< Iterator in storage order. */
+    using const_iterator = typename storage_type::const_iterator; /**< Const iterator in storage order. */
+
+private:
+    /** Marker for IDs without a live object. */
+    static constexpr size_type NO_SLOT = std::numeric_limits<size_type>::max();
+
+    storage_type dense;           /**< The live objects, packed. */
+    std::vector<size_type> slots; /**< Map from ID value, less first, to index in dense, or NO_SLOT. */
+    id_value_type first = 0;      /**< The ID value of the first entry of slots. */
+    size_type head = 0;           /**< The number of empty entries at the front of slots. */
+
+    /**
+     * Get the dense index of an ID.
+     * @param id The ID.
+     * @return The index of the object in dense, or NO_SLOT if there is none.
+     */
+    size_type slot(const id_type &id) const {
+        if (id.value < first) {
+            return NO_SLOT;
+        }
+        const auto offset = static_cast<size_type>(id.value - first);
+        return offset < slots.size() ? slots[offset] : NO_SLOT;
+    }
+
+    /** Skip empty entries at the front of the slot table, dropping them once they are half of it. */
+    void trim() {
+        while (head < slots.size() && slots[head] == NO_SLOT) {
+            head++;
+        }
+        if (head > 0 && head * 2 >= slots.size()) {
+            slots.erase(slots.begin(), slots.begin() + head);
+            first += static_cast<id_value_type>(head);
+            head = 0;
+        }
+    }
+
+public:
+    /**
+     * Get whether there is a live object with an ID.
+     * @param id The ID.
+     * @return True if the object is present.
+     */
+    bool contains(const id_type &id) const {
+        return slot(id) != NO_SLOT;
+    }
+
+    /**
+     * Get an object by ID, or nullptr if there is none.
+     * @param id The ID.
+     * @return Pointer to the object.
+     */
+    T *find(const id_type &id) {
+        const auto index = slot(id);
+        return index == NO_SLOT ? nullptr : &dense[index];
+    }
+
+    /**
+     * Get an object by ID, or nullptr if there is none.
+     * @param id The ID.
+     * @return Pointer to the object.
+     */
+    const T *find(const id_type &id) const {
+        const auto index = slot(id);
+        return index == NO_SLOT ? nullptr : &dense[index];
+    }
+
+    /**
+     * Get an object by ID, which must be present.
+     * @param id The ID.
+     * @return Reference to the object.
+     */
+    T &at(const id_type &id) {
+        const auto index = slot(id);
+        assert(index != NO_SLOT);
+        return dense[index];
+    }
+
+    /**
+     * Get an object by ID, which must be present.
+     * @param id The ID.
+     * @return Reference to the object.
+     */
+    const T &at(const id_type &id) const {
+        const auto index = slot(id);
+        assert(index != NO_SLOT);
+        return dense[index];
+    }
+
+    /**
+     * Add an object, whose ID must be greater than every ID added before.
+     * @param object The object.
+     * @return Reference to the stored object, valid until the next insertion or removal.
+     */
+    T &insert(T object) {
+        assert(object.id.value >= first + static_cast<id_value_type>(slots.size()));
+        if (slots.empty()) {
+            first = object.id.value;
+        }
+        const auto offset = static_cast<size_type>(object.id.value - first);
+        slots.resize(offset + 1, NO_SLOT);
+        slots[offset] = dense.size();
+        dense.push_back(std::move(object));
+        return dense.back();
+    }
+
+    /**
+     * Remove an object by ID, which must be present. The last object in storage takes its place.
+     * @param id The ID.
+     */
+    void erase(const id_type &id) {
+        const auto index = slot(id);
+        assert(index != NO_SLOT);
+        slots[static_cast<size_type>(id.value - first)] = NO_SLOT;
+        if (index + 1 != dense.size()) {
+            dense[index] = std::move(dense.back());
+            slots[static_cast<size_type>(dense[index].id.value - first)] = index;
+        }
+        dense.pop_back();
+        trim();
+    }
+
+    /** Remove all objects. IDs handed out before remain unusable. */
+    void clear() {
+        dense.clear();
+        first += static_cast<id_value_type>(slots.size());
+        slots.clear();
+        head = 0;
+    }
+
+    /** Remove all objects and forget their IDs, so that objects may be inserted again from any ID. */
+    void reset() {
+        dense.clear();
+        slots.clear();
+        first = 0;
+        head = 0;
+    }
+
+    /**
+     * Reserve room for a number of live objects.
+     * @param capacity The number of objects.
+     */
+    void reserve(size_type capacity) {
+        dense.reserve(capacity);
+    }
+
+    /**
+     * Visit the live objects in ID order, walking the slot table.
+     * @param visit Function called with each object.
+     */
+    template<class F>
+    void for_each_in_id_order(F &&visit) {
+        for (auto offset = head; offset < slots.size(); offset++) {
+            if (slots[offset] != NO_SLOT) {
+                visit(dense[slots[offset]]);
+            }
+        }
+    }
+
+    /**
+     * Visit the live objects in ID order, walking the slot table.
+     * @param visit Function called with each object.
+     */
+    template<class F>
+    void for_each_in_id_order(F &&visit) const {
+        for (auto offset = head; offset < slots.size(); offset++) {
+            if (slots[offset] != NO_SLOT) {
+                visit(dense[slots[offset]]);
+            }
+        }
+    }
+
+    /** Get the number of live objects. */
+    size_type size() const { return dense.size(); }
+
+    /** Get the number of entries in the slot table, which bounds the span of live IDs. */
+    size_type slot_count() const { return slots.size(); }
+
+    /** Get whether there are no live objects. */
+    bool empty() const { return dense.empty(); }
+
+    /** Get an iterator to the first live object in storage. */
+    iterator begin() { return dense.begin(); }
+
+    /** Get an iterator past the last live object in storage. */
+    iterator end() { return dense.end(); }
+
+    /** Get an iterator to the first live object in storage. */
+    const_iterator begin() const { return dense.begin(); }
+
+    /** Get an iterator past the last live object in storage. */
+    const_iterator end() const { return dense.end(); }
+};
+
+#endif // SLOTMAP_HPP
@@ -0,0 +1,135 @@
+#ifndef MPSC_QUEUE_HPP
+#define MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+/**
+ * Bounded lock-free queue with many producers and a single consumer.
+ *
+ * Each slot of the ring carries a sequence number telling whose turn it is: a producer may fill slot i once its
+ * sequence equals the claimed position, and the consumer may empty it once the sequence is one past that. Producers
+ * claim positions with a compare-and-swap on the tail; the head is only touched by the consumer.
+ *
+ * Producers that find the queue full can block in push() instead of spinning. Only that slow path takes a lock: the
+ * consumer signals it after every pop, so producers sleep while the consumer is busy elsewhere.
+ *
+ * @tparam T The type of queued items, which must be default constructible and movable.
+ */
+template<class T>
+class BoundedMpscQueue {
+    /** A slot of the ring. */
+    struct Cell {
+        std::atomic<std::size_t> sequence; /**< The position this slot is waiting for. */
+        T value;                           /**< The item, valid while the slot is full. */
+    };
+
+    std::unique_ptr<Cell[]> cells;  /**< The ring of slots. */
+    std::size_t mask;               /**< The capacity minus one, for wrapping positions. */
+
+    /** The next position to fill, shared by producers. */
+    alignas(64) std::atomic<std::size_t> tail{0};
+
+    /** The next position to empty, owned by the consumer. */
+    alignas(64) std::size_t head{0};
+
+    std::mutex space_mutex;                     /**< Orders a blocked producer's last check before its wait. */
+    std::condition_variable space_available;    /**< Signaled when a slot empties or producers must recheck. */
+
+public:
+    /**
+     * Create an empty queue.
+     * @param capacity The maximum number of queued items, a power of two of at least 2. With one slot, a full slot
+     * and the next lap's empty one would have the same sequence number.
+     */
+    explicit BoundedMpscQueue(std::size_t capacity) : cells(new Cell[capacity]), mask(capacity - 1) {
+        assert(capacity >= 2 && (capacity & mask) == 0);
+        for (std::size_t position = 0; position < capacity; position++) {
+            cells[position].sequence.store(position, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedMpscQueue(const BoundedMpscQueue &) = delete;
+    BoundedMpscQueue &operator=(const BoundedMpscQueue &) = delete;
+
+    /**
+     * Add an item if there is room. Safe to call from any number of threads.
+     * @param value The item, which is moved from only if it was queued.
+     * @return True if the item was queued, false if the queue was full.
+     */
+    bool try_push(T &&value) {
+        auto position = tail.load(std::memory_order_relaxed);
+        Cell *cell;
+        while (true) {
+            cell = &cells[position & mask];
+            const auto sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+            if (difference == 0) {
+                // The slot is free; try to claim the position.
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                // The slot still holds an item from the last lap, so the queue is full.
+                return false;
+            } else {
+                // Another producer claimed the position first.
+                position = tail.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(value);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Remove the oldest item if there is one. Must only be called from the consumer thread.
+     * @param value Set to the item.
+     * @return True if an item was removed, false if the queue was empty.
+     */
+    bool try_pop(T &value) {
+        auto &cell = cells[head & mask];
+        if (cell.sequence.load(std::memory_order_acquire) != head + 1) {
+            return false;
+        }
+        value = std::move(cell.value);
+        cell.sequence.store(head + mask + 1, std::memory_order_release);
+        head++;
+        wake_producers();
+        return true;
+    }
+
+    /**
+     * Add an item, blocking while the queue is full. Safe to call from any number of threads.
+     * @param value The item, which is moved from only if it was queued.
+     * @param stop Called whenever the producer wakes; returning true gives up without queueing the item.
+     * @return True if the item was queued, false if stop asked to give up.
+     */
+    template<class Stop>
+    bool push(T &&value, Stop stop) {
+        if (try_push(std::move(value))) {
+            return true;
+        }
+        bool pushed = false;
+        std::unique_lock<std::mutex> lock(space_mutex);
+        // A pop signals under the lock, so it cannot slip in between a failed try and the wait.
+        space_available.wait(lock, [&] {
+            pushed = try_push(std::move(value));
+            return pushed || stop();
+        });
+        return pushed;
+    }
+
+    /** Wake every producer blocked in push(), so it checks for room and for its stop condition again. */
+    void wake_producers() {
+        { std::lock_guard<std::mutex> guard(space_mutex); }
+        space_available.notify_all();
+    }
+};
+
+#endif // MPSC_QUEUE_HPP
@@ -0,0 +1,160 @@
+#ifndef OBSERVATION_HPP
+#define OBSERVATION_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Bitboard.hpp"
+#include "../types.hpp"
+#include "rollout_buffer.hpp"
+
+#include <torch/torch.h>
+
+/*Encoding of stored rollout steps into the input frames of the neural network, shared by the learner and the rollout workers*/
+
+const std::size_t FRAME_SIZE = GAME_HEIGHT * GAME_WIDTH;                        //Floats in one NxN frame
+const std::size_t OBSERVATION_SIZE = NUMBER_OF_FRAMES * FRAME_SIZE;             //Floats in the observation of one entity
+const std::size_t SHARED_OBSERVATION_SIZE = NUMBER_OF_SHARED_FRAMES * FRAME_SIZE; //Floats in the frames shared by a player's ships
+const std::size_t SHIP_OBSERVATION_SIZE = NUMBER_OF_SHIP_FRAMES * FRAME_SIZE;   //Floats in the frames specific to one ship
+
+/*
+ * Write the frames shared by every ship of a player on a stored turn, in network input order:
+ * halite, steps remaining, then ships, ship halite, dropoffs and score for the player and for its enemies.
+ */
+inline void encodeSharedFrames(const RolloutBuffer &rollouts, std::size_t turn, long playerId, float *frames) {
+    float *halite_location = frames;
+    float *steps_remaining = frames + FRAME_SIZE;
+    float *my_ships = frames + 2 * FRAME_SIZE;
+    float *my_ships_halite = frames + 3 * FRAME_SIZE;
+    float *my_dropoffs = frames + 4 * FRAME_SIZE;
+    float *my_score = frames + 5 * FRAME_SIZE;
+    float *enemy_ships = frames + 6 * FRAME_SIZE;
+    float *enemy_ships_halite = frames + 7 * FRAME_SIZE;
+    float *enemy_dropoffs = frames + 8 * FRAME_SIZE;
+    float *enemy_score = frames + 9 * FRAME_SIZE;
+
+    std::fill(steps_remaining, steps_remaining + FRAME_SIZE, rollouts.stepsRemaining[turn]);
+
+    //TODO: Generalize for more players
+    const auto myIndex = playerId == 0 ? 0 : 1;
+    const float *scores = rollouts.scores.data() + turn * NUMBER_OF_PLAYERS;
+    std::fill(my_score, my_score + FRAME_SIZE, scores[myIndex]);
+    std::fill(enemy_score, enemy_score + FRAME_SIZE, scores[1 - myIndex]);
+
+    const auto first = turn * FRAME_SIZE;
+    const uint16_t *haliteOnGround = rollouts.haliteOnGround.data() + first;
+    const uint16_t *haliteOnShip = rollouts.haliteOnShip.data() + first;
+    for(std::size_t index = 0; index < FRAME_SIZE; index++) {
+        halite_location[index] = (haliteOnGround[index] / MAX_HALITE_ON_MAP) - 0.5;
+    }
+
+    //Occupancy and structures come straight from the stored bitboards, the enemies' merged row by row
+    const auto firstRow = turn * RolloutBuffer::TURN_ROWS;
+    const auto *myShipRows = rollouts.shipRows.data() + firstRow + playerId * GAME_HEIGHT;
+    const auto *myStructureRows = rollouts.structureRows.data() + firstRow + playerId * GAME_HEIGHT;
+    hlt::Bitboard::row_type enemyShipRows[GAME_HEIGHT] = {};
+    hlt::Bitboard::row_type enemyStructureRows[GAME_HEIGHT] = {};
+    for(long player = 0; player < NUMBER_OF_PLAYERS; player++) {
+        if(player == playerId) {
+            continue;
+        }
+        for(int y = 0; y < GAME_HEIGHT; y++) {
+            enemyShipRows[y] |= rollouts.shipRows[firstRow + player * GAME_HEIGHT + y];
+            enemyStructureRows[y] |= rollouts.structureRows[firstRow + player * GAME_HEIGHT + y];
+        }
+    }
+    hlt::Bitboard::write_plane(myShipRows, GAME_WIDTH, GAME_HEIGHT, my_ships);
+    hlt::Bitboard::write_plane(myStructureRows, GAME_WIDTH, GAME_HEIGHT, my_dropoffs);
+    hlt::Bitboard::write_plane(enemyShipRows, GAME_WIDTH, GAME_HEIGHT, enemy_ships);
+    hlt::Bitboard::write_plane(enemyStructureRows, GAME_WIDTH, GAME_HEIGHT, enemy_dropoffs);
+
+    //Only the cells holding ships carry halite, so visit just the set bits
+    std::fill(my_ships_halite, my_ships_halite + FRAME_SIZE, 0.0f);
+    std::fill(enemy_ships_halite, enemy_ships_halite + FRAME_SIZE, 0.0f);
+    for(int y = 0; y < GAME_HEIGHT; y++) {
+        for(auto bits = myShipRows[y]; bits != 0; bits &= bits - 1) {
+            const auto index = y * GAME_WIDTH + __builtin_ctzll(bits);
+            my_ships_halite[index] = (haliteOnShip[index] / MAX_HALITE_ON_SHIP) - 0.5;
+        }
+        for(auto bits = enemyShipRows[y]; bits != 0; bits &= bits - 1) {
+            const auto index = y * GAME_WIDTH + __builtin_ctzll(bits);
+            enemy_ships_halite[index] = (haliteOnShip[index] / MAX_HALITE_ON_SHIP) - 0.5;
+        }
+    }
+}
+
+/*Write the frames specific to the ship of a stored step: its location and the halite it carries*/
+inline void encodeShipFrames(const RolloutBuffer &rollouts, std::size_t step, float *frames) {
+    float *entity_location = frames;
+    float *entity_energy = frames + FRAME_SIZE;
+    std::fill(entity_location, entity_location + SHIP_OBSERVATION_SIZE, 0.0f);
+    const auto index = rollouts.shipY[step] * GAME_WIDTH + rollouts.shipX[step];
+    entity_location[index] = 1;
+    entity_energy[index] = (rollouts.shipEnergy[step] / MAX_HALITE_ON_SHIP) - 0.5;
+}
+
+/*
+ * A batch of observations split into the frames shared by each (turn, player) and the frames of each ship.
+ * The full observation of ship i is shared[sharedIndex[i]] followed by ship[i].
+ */
+struct SplitObservations {
+    torch::Tensor shared;       //[S, NUMBER_OF_SHARED_FRAMES, GAME_HEIGHT, GAME_WIDTH], one per distinct turn and player
+    torch::Tensor sharedIndex;  //[B], the row of shared used by each ship
+    torch::Tensor ship;         //[B, NUMBER_OF_SHIP_FRAMES, GAME_HEIGHT, GAME_WIDTH]
+};
+
+/*Reusable memory behind SplitObservations*/
+struct SplitObservationBuffers {
+    std::vector<float> shared;
+    std::vector<int64_t> sharedIndex;
+    std::vector<float> ship;
+    std::vector<std::pair<std::size_t, long>> sharedKeys;   //The turn and player of each row of shared
+    std::vector<int64_t> sharedRows;    //Row of shared for each turn * NUMBER_OF_PLAYERS + player, or -1 if not encoded yet
+};
+
+/*
+ * Encode stored steps as shared and per-ship blocks in reusable buffers.
+ * Each distinct (turn, player) pair is encoded once however many ships it has.
+ * The tensors share the buffers' memory, so the buffers must not be changed until the tensors are no longer used.
+ */
+inline SplitObservations encodeSteps(const RolloutBuffer &rollouts, const std::vector<std::size_t> &steps, SplitObservationBuffers &buffers) {
+    const auto batchSize = steps.size();
+    buffers.sharedKeys.clear();
+    buffers.sharedRows.resize(rollouts.turns() * NUMBER_OF_PLAYERS, -1);
+    buffers.sharedIndex.resize(batchSize);
+    buffers.ship.resize(batchSize * SHIP_OBSERVATION_SIZE);
+
+    for(std::size_t i = 0; i < batchSize; i++) {
+        const auto step = steps[i];
+        const std::pair<std::size_t, long> key{rollouts.turn[step], rollouts.playerId[step]};
+        assert(key.second >= 0 && key.second < NUMBER_OF_PLAYERS);
+
+        auto &sharedRow = buffers.sharedRows[key.first * NUMBER_OF_PLAYERS + key.second];
+        if(sharedRow < 0) {
+            sharedRow = static_cast<int64_t>(buffers.sharedKeys.size());
+            buffers.sharedKeys.push_back(key);
+            buffers.shared.resize(buffers.sharedKeys.size() * SHARED_OBSERVATION_SIZE);
+            encodeSharedFrames(rollouts, key.first, key.second, buffers.shared.data() + sharedRow * SHARED_OBSERVATION_SIZE);
+        }
+
+        buffers.sharedIndex[i] = sharedRow;
+        encodeShipFrames(rollouts, step, buffers.ship.data() + i * SHIP_OBSERVATION_SIZE);
+    }
+
+    //Forget this batch's rows, so the table is all -1 again for the next call whatever rollouts it gets
+    for(const auto &key : buffers.sharedKeys) {
+        buffers.sharedRows[key.first * NUMBER_OF_PLAYERS + key.second] = -1;
+    }
+
+    const auto sharedCount = static_cast<long>(buffers.sharedKeys.size());
+    SplitObservations observations;
+    observations.shared = torch::from_blob(buffers.shared.data(), {sharedCount, NUMBER_OF_SHARED_FRAMES, GAME_HEIGHT, GAME_WIDTH});
+    observations.sharedIndex = torch::from_blob(buffers.sharedIndex.data(), {static_cast<long>(batchSize)}, torch::kLong);
+    observations.ship = torch::from_blob(buffers.ship.data(), {static_cast<long>(batchSize), NUMBER_OF_SHIP_FRAMES, GAME_HEIGHT, GAME_WIDTH});
+    return observations;
+}
+
+#endif
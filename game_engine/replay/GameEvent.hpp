@@ -8,6 +8,7 @@
 #include "Map.hpp"
 #include "Statistics.hpp"
 #include <memory>
+#include <utility>
 
 
 namespace hlt {
@@ -93,7 +94,7 @@ public:
      * @param location Location of entity death
      * @param owner_id Owner of dying entity
      */
-    CollisionEvent(Location location, std::vector<Entity::id_type> ships) : BaseEvent(location), ships(ships) {};
+    CollisionEvent(Location location, std::vector<Entity::id_type> ships) : BaseEvent(location), ships(std::move(ships)) {};
     ~CollisionEvent() override  = default;
 
     virtual void update_stats(const Store &store, const Map &map, GameStatistics &stats) override;
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <tuple>
+
 #include "Replay.hpp"
 namespace hlt {
 
@@ -10,9 +13,8 @@ void Turn::add_entities(Store &store) {
     for (const auto &[player_id, _player] : store.players) {
         entities[player_id] = {};
     }
-    for (const auto &[entity_id, entity] : store.entities) {
-        const auto location = store.get_player(entity.owner).get_entity_location(entity.id);
-        const EntityInfo entity_info = {location, entity};
+    for (const auto &entity : store.entities) {
+        const EntityInfo entity_info = {entity.location, entity};
         entities[entity.owner].insert( {{entity.id, entity_info}} );
     }
 }
@@ -22,7 +24,12 @@ void Turn::add_entities(Store &store) {
  * @param map The game map (to access cell energy)
  * @param cells The locations of changed cells
  */
-void Turn::add_cells(Map &map, std::unordered_set<Location> changed_cells){
+void Turn::add_cells(Map &map, std::vector<Location> changed_cells){
+    // A cell may have been changed more than once, so record each one only once.
+    std::sort(changed_cells.begin(), changed_cells.end(), [](const Location &first, const Location &second) {
+        return std::tie(first.y, first.x) < std::tie(second.y, second.x);
+    });
+    changed_cells.erase(std::unique(changed_cells.begin(), changed_cells.end()), changed_cells.end());
     for (const auto location : changed_cells) {
         const auto cell = map.at(location);
         this->cells.emplace_back(location, cell);
@@ -65,7 +65,7 @@ struct Turn {
      * @param map The game map (to access cell energy)
      * @param cells The locations of changed cells
      */
-    void add_cells(Map &map, std::unordered_set<Location> changed_cells);
+    void add_cells(Map &map, std::vector<Location> changed_cells);
 
     /**
      * Given the game store, add all state from end of turn in replay
@@ -0,0 +1,235 @@
+#ifndef ROLLOUT_BUFFER_HPP
+#define ROLLOUT_BUFFER_HPP
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "Bitboard.hpp"
+#include "Halite.hpp"
+#include "../types.hpp"
+
+/*
+ * Rollouts stored as columns instead of one heap-allocated state per ship.
+ *
+ * Every turn of every game is stored once, as planes of the raw integers the engine uses: halite on the ground and
+ * in ships as uint16, and the engine's per-player ship and structure bitboards as one word per row. Each step (one ship on one turn) refers to its turn by
+ * index, and its action, log probability, value, reward and done flag live in contiguous arrays.
+ * The network input is decoded from these planes with the same scaling the engine state would get, so encoding a
+ * step from the buffer gives exactly the same floats as encoding it from the live game.
+ */
+class RolloutBuffer {
+public:
+    static constexpr std::size_t TURN_CELLS = GAME_HEIGHT * GAME_WIDTH;    //Cells in the planes of one turn
+    static constexpr std::size_t TURN_ROWS = NUMBER_OF_PLAYERS * GAME_HEIGHT;  //Bitboard words of each kind in one turn
+    static_assert(GAME_WIDTH <= hlt::Bitboard::MAX_WIDTH, "a row of the map must fit in one bitboard word");
+
+    //One entry per cell of each turn, row-major
+    std::vector<uint16_t> haliteOnGround;
+    std::vector<uint16_t> haliteOnShip;
+
+    //One bitboard per player of each turn, player-major, one word per row: bit x of row y is cell (x, y)
+    std::vector<hlt::Bitboard::row_type> shipRows;
+    std::vector<hlt::Bitboard::row_type> structureRows;
+
+    //One entry per turn, already scaled for the network
+    std::vector<float> stepsRemaining;
+    std::vector<float> scores;              //NUMBER_OF_PLAYERS entries per turn
+
+    //One entry per step
+    std::vector<uint32_t> turn;             //Index of the turn the step was taken on
+    std::vector<uint32_t> game;             //Identifies the game, so steps of different games are never mixed up
+    std::vector<int32_t> entity;            //ID of the ship within its game
+    std::vector<uint8_t> playerId;
+    std::vector<uint8_t> shipY;
+    std::vector<uint8_t> shipX;
+    std::vector<uint16_t> shipEnergy;
+    std::vector<uint8_t> action;
+    std::vector<float> logProb;
+    std::vector<float> value;
+    std::vector<float> reward;
+    std::vector<uint8_t> done;              //This seems backwards but we represent "Done" as 0 and "Not done" as 1
+    std::vector<int32_t> policyVersion;     //Version of the policy that chose the action
+
+    /*Number of turns stored*/
+    std::size_t turns() const {
+        return stepsRemaining.size();
+    }
+
+    /*Number of steps stored*/
+    std::size_t size() const {
+        return turn.size();
+    }
+
+    bool empty() const {
+        return turn.empty();
+    }
+
+    /*Store the current state of a game as a new turn, returning its index*/
+    std::size_t add_turn(hlt::Halite &game) {
+        assert(game.map.height == GAME_HEIGHT && game.map.width == GAME_WIDTH);
+
+        const auto turnIndex = turns();
+        const auto first = haliteOnGround.size();
+        haliteOnGround.resize(first + TURN_CELLS);
+        haliteOnShip.resize(first + TURN_CELLS, 0);
+
+        for(int y = 0; y < GAME_HEIGHT; y++) {
+            const auto row = game.map.row(y);
+            for(int x = 0; x < GAME_WIDTH; x++) {
+                const auto &cell = row[x];
+                const auto index = first + y * GAME_WIDTH + x;
+                assert(cell.energy >= 0 && cell.energy <= UINT16_MAX);
+                haliteOnGround[index] = static_cast<uint16_t>(cell.energy);
+
+                if(cell.entity.value != -1) {
+                    //There is a ship here
+                    haliteOnShip[index] = static_cast<uint16_t>(game.store.get_entity(cell.entity).energy);
+                }
+            }
+        }
+
+        //The engine keeps the bitboards current after every turn; structures count factories along with dropoffs
+        const auto &bitboards = game.bitboards();
+        assert(bitboards.supported());
+        const auto firstRow = shipRows.size();
+        shipRows.resize(firstRow + TURN_ROWS, 0);
+        structureRows.resize(firstRow + TURN_ROWS, 0);
+
+        scores.resize(scores.size() + NUMBER_OF_PLAYERS);
+        for(const auto &playerPair : game.store.players) {
+            const auto &player = playerPair.second;
+            assert(player.id.value >= 0 && player.id.value < NUMBER_OF_PLAYERS);
+
+            const auto playerRow = firstRow + player.id.value * GAME_HEIGHT;
+            const auto &ships = bitboards.ships(player.id);
+            const auto &structures = bitboards.structures(player.id);
+            for(int y = 0; y < GAME_HEIGHT; y++) {
+                shipRows[playerRow + y] = ships.row(y);
+                structureRows[playerRow + y] = structures.row(y);
+            }
+
+            // Player score
+            auto floatScore = (float)player.energy;
+            scores[turnIndex * NUMBER_OF_PLAYERS + player.id.value] = (floatScore / MAX_SCORE_APPROXIMATE) - 0.5;
+        }
+
+        //Steps remaining, normalized between [-0.5, 0.5]
+        int totalSteps = 0;
+        switch(GAME_HEIGHT) {
+            case 64: totalSteps = 501; break;
+            case 56: totalSteps = 476; break;
+            case 48: totalSteps = 451; break;
+            case 40: totalSteps = 426; break;
+            default: totalSteps = 401; break;
+        }
+        float steps_remaining_value = totalSteps - game.turn_number + 1;
+        stepsRemaining.push_back((steps_remaining_value / float(totalSteps)) - 0.5);
+
+        return turnIndex;
+    }
+
+    /*Store a ship awaiting an action on a turn, returning the index of the step*/
+    std::size_t add_step(std::size_t turnIndex, uint32_t gameId, hlt::Entity::id_type entityId, long owner, hlt::Location location, hlt::energy_type energy) {
+        assert(turnIndex < turns());
+        const auto index = size();
+        turn.push_back(static_cast<uint32_t>(turnIndex));
+        game.push_back(gameId);
+        entity.push_back(static_cast<int32_t>(entityId.value));
+        playerId.push_back(static_cast<uint8_t>(owner));
+        shipY.push_back(static_cast<uint8_t>(location.y));
+        shipX.push_back(static_cast<uint8_t>(location.x));
+        shipEnergy.push_back(static_cast<uint16_t>(energy));
+        action.push_back(0);
+        logProb.push_back(0);
+        value.push_back(0);
+        reward.push_back(0);
+        done.push_back(1);
+        policyVersion.push_back(-1);
+        return index;
+    }
+
+    /*
+     * Append turns [firstTurn, firstTurn + turnCount) of another buffer, along with steps [firstStep, firstStep + stepCount),
+     * which must all have been taken on those turns.
+     */
+    void append(const RolloutBuffer &other, std::size_t firstTurn, std::size_t turnCount, std::size_t firstStep, std::size_t stepCount) {
+        const auto turnOffset = static_cast<int64_t>(turns()) - static_cast<int64_t>(firstTurn);
+
+        append_range(haliteOnGround, other.haliteOnGround, firstTurn * TURN_CELLS, turnCount * TURN_CELLS);
+        append_range(haliteOnShip, other.haliteOnShip, firstTurn * TURN_CELLS, turnCount * TURN_CELLS);
+        append_range(shipRows, other.shipRows, firstTurn * TURN_ROWS, turnCount * TURN_ROWS);
+        append_range(structureRows, other.structureRows, firstTurn * TURN_ROWS, turnCount * TURN_ROWS);
+        append_range(stepsRemaining, other.stepsRemaining, firstTurn, turnCount);
+        append_range(scores, other.scores, firstTurn * NUMBER_OF_PLAYERS, turnCount * NUMBER_OF_PLAYERS);
+
+        for(std::size_t i = firstStep; i < firstStep + stepCount; i++) {
+            assert(other.turn[i] >= firstTurn && other.turn[i] < firstTurn + turnCount);
+            turn.push_back(static_cast<uint32_t>(other.turn[i] + turnOffset));
+        }
+        append_range(game, other.game, firstStep, stepCount);
+        append_range(entity, other.entity, firstStep, stepCount);
+        append_range(playerId, other.playerId, firstStep, stepCount);
+        append_range(shipY, other.shipY, firstStep, stepCount);
+        append_range(shipX, other.shipX, firstStep, stepCount);
+        append_range(shipEnergy, other.shipEnergy, firstStep, stepCount);
+        append_range(action, other.action, firstStep, stepCount);
+        append_range(logProb, other.logProb, firstStep, stepCount);
+        append_range(value, other.value, firstStep, stepCount);
+        append_range(reward, other.reward, firstStep, stepCount);
+        append_range(done, other.done, firstStep, stepCount);
+        append_range(policyVersion, other.policyVersion, firstStep, stepCount);
+    }
+
+    /*Append every turn and step of another buffer*/
+    void append(const RolloutBuffer &other) {
+        append(other, 0, other.turns(), 0, other.size());
+    }
+
+    /*Remove every turn and step, keeping the memory for reuse*/
+    void clear() {
+        haliteOnGround.clear();
+        haliteOnShip.clear();
+        shipRows.clear();
+        structureRows.clear();
+        stepsRemaining.clear();
+        scores.clear();
+        turn.clear();
+        game.clear();
+        entity.clear();
+        playerId.clear();
+        shipY.clear();
+        shipX.clear();
+        shipEnergy.clear();
+        action.clear();
+        logProb.clear();
+        value.clear();
+        reward.clear();
+        done.clear();
+        policyVersion.clear();
+    }
+
+    /*Bytes used by the stored turns and steps, not counting spare capacity*/
+    std::size_t memory_bytes() const {
+        const auto turnBytes = TURN_CELLS * 2 * sizeof(uint16_t) + TURN_ROWS * 2 * sizeof(hlt::Bitboard::row_type) + (1 + NUMBER_OF_PLAYERS) * sizeof(float);
+        const auto stepBytes = 2 * sizeof(uint32_t) + 2 * sizeof(int32_t) + sizeof(uint16_t) + 5 * sizeof(uint8_t) + 3 * sizeof(float);
+        return turns() * turnBytes + size() * stepBytes;
+    }
+
+private:
+    template<class T>
+    static void append_range(std::vector<T> &to, const std::vector<T> &from, std::size_t first, std::size_t count) {
+        to.insert(to.end(), from.begin() + first, from.begin() + first + count);
+    }
+};
+
+/*The rollouts of one finished game, as produced by a rollout worker*/
+struct Trajectory {
+    RolloutBuffer rollouts;
+    std::vector<long> scores;
+    long gameSteps;
+    unsigned int seed;          //Map seed of the game, which replays it along with policyVersion
+    long policyVersion;         //Version of the policy that played every turn of the game
+};
+
+#endif
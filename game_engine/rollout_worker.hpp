@@ -0,0 +1,262 @@
+#ifndef ROLLOUT_WORKER_HPP
+#define ROLLOUT_WORKER_HPP
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../types.hpp"
+#include "../model.hpp"
+#include "mpsc_queue.hpp"
+#include "observation.hpp"
+#include "rollout_buffer.hpp"
+#include "vec_env.hpp"
+
+#include <ATen/Parallel.h>
+#include <torch/torch.h>
+
+/*Copy the weights of one network into another network of the same shape, on any device*/
+inline void copy_weights(const ActorCriticNetwork &from, ActorCriticNetwork &to) {
+    torch::NoGradGuard noGrad;
+    auto source = from.parameters();
+    auto destination = to.parameters();
+    for(std::size_t i = 0; i < source.size(); i++) {
+        destination[i].copy_(source[i]);
+    }
+}
+
+/*
+ * The latest policy published by the learner.
+ * Every publication is a fresh CPU copy tagged with the next version number, and is never modified afterwards,
+ * so workers can copy from it while the learner keeps training.
+ */
+class PolicyStore {
+    mutable std::mutex mutex;
+    std::shared_ptr<const ActorCriticNetwork> policy;
+    std::atomic<long> version{-1};
+
+public:
+    /*Publish a copy of the learner's network as the next version, returning that version*/
+    long publish(const ActorCriticNetwork &model) {
+        auto snapshot = std::make_shared<ActorCriticNetwork>(false);
+        copy_weights(model, *snapshot);
+
+        std::lock_guard<std::mutex> guard(mutex);
+        policy = snapshot;
+        const auto next = version.load(std::memory_order_relaxed) + 1;
+        version.store(next, std::memory_order_release);
+        return next;
+    }
+
+    /*Get the latest version number without taking the lock, or -1 if nothing was published yet*/
+    long current_version() const {
+        return version.load(std::memory_order_acquire);
+    }
+
+    /*Get the latest policy along with its version*/
+    long latest(std::shared_ptr<const ActorCriticNetwork> &snapshot) const {
+        std::lock_guard<std::mutex> guard(mutex);
+        snapshot = policy;
+        return version.load(std::memory_order_relaxed);
+    }
+};
+
+/*
+ * A thread playing its own set of games with its own copies of the policy.
+ * Each game is played from its first turn to its last by the latest version published when it started, so it can be
+ * replayed from its map seed and that version alone, whenever the learner publishes and however many workers run.
+ * New weights are picked up as games end and the next ones start; the version is recorded on each rollout and on the
+ * game's Trajectory. Finished games are pushed to the learner's queue; when the queue is full the worker waits,
+ * which keeps it from running far ahead of the learner.
+ */
+class RolloutWorker {
+    /*A copy of one published version of the policy*/
+    struct PolicyCopy {
+        long version;
+        std::unique_ptr<ActorCriticNetwork> network;    //Stays on the CPU, whichever device the learner trains on
+    };
+
+    static constexpr std::size_t NO_POLICY = std::numeric_limits<std::size_t>::max();
+
+    PolicyStore &policies;
+    BoundedMpscQueue<Trajectory> &trajectories;
+
+    VecHaliteEnv env;
+    std::vector<PolicyCopy> policyCopies;           //The versions games are playing, and spare copies to reuse
+    std::vector<std::size_t> slotPolicies;          //Index in policyCopies of the version each game slot plays
+    std::vector<RolloutBuffer> pendingRollouts;     //Rollouts of each game that has not ended yet
+    RolloutBuffer currentTurn;                      //Every game and ship of the current turn, reused every turn
+    std::vector<std::size_t> currentSteps;          //Steps of currentTurn to encode, reused every turn
+    SplitObservationBuffers observationBuffers;     //Network input of the current turn, reused every turn
+    std::vector<float> draws;                       //Uniform draws sampling the actions of the current turn
+    std::vector<long> actions;                      //Action of each ship of the current turn, reused every turn
+
+    std::atomic<bool> stopping{false};
+    std::thread thread;
+
+    /*Give a slot starting a new game the latest published version, which it keeps until that game ends*/
+    void start_game(std::size_t slot) {
+        std::shared_ptr<const ActorCriticNetwork> latest;
+        const auto version = policies.latest(latest);
+
+        //Another game may already play this version; otherwise reuse a copy no other game plays
+        auto spare = NO_POLICY;
+        for(std::size_t copy = 0; copy < policyCopies.size(); copy++) {
+            if(policyCopies[copy].version == version) {
+                slotPolicies[slot] = copy;
+                return;
+            }
+            bool used = false;
+            for(std::size_t other = 0; other < slotPolicies.size(); other++) {
+                used = used || (other != slot && slotPolicies[other] == copy);
+            }
+            if(!used && spare == NO_POLICY) {
+                spare = copy;
+            }
+        }
+        if(spare == NO_POLICY) {
+            spare = policyCopies.size();
+            policyCopies.push_back(PolicyCopy{-1, std::make_unique<ActorCriticNetwork>(false)});
+        }
+        copy_weights(*latest, *policyCopies[spare].network);
+        policyCopies[spare].version = version;
+        slotPolicies[slot] = spare;
+    }
+
+    /*Play one turn of every game, queueing the rollouts of the games that end*/
+    void step() {
+        const auto &ships = env.ships();
+
+        //Each game is stored once, then shared by all of its ships
+        currentTurn.clear();
+        for(std::size_t i = 0; i < env.size(); i++) {
+            currentTurn.add_turn(env.game(i));
+        }
+        for(const auto &ship : ships) {
+            currentTurn.add_step(ship.game, static_cast<uint32_t>(ship.game), ship.entity, ship.player_id, ship.location, ship.energy);
+        }
+
+        //Ask the neural network what to do, once per version for the ships of the games playing it; usually every
+        //game plays the same version. Step i of currentTurn is ship i
+        actions.resize(ships.size());
+        for(std::size_t copy = 0; copy < policyCopies.size(); copy++) {
+            currentSteps.clear();
+            for(std::size_t i = 0; i < ships.size(); i++) {
+                if(slotPolicies[ships[i].game] == copy) {
+                    currentSteps.push_back(i);
+                }
+            }
+            if(currentSteps.empty()) {
+                continue;
+            }
+
+            torch::Tensor emptyAction;
+            auto observations = encodeSteps(currentTurn, currentSteps, observationBuffers);
+
+            //Each ship's draw depends only on its game's seed, the turn and its ID, so an episode samples the
+            //same actions from the same weights whichever worker, slot or thread plays it
+            draws.resize(currentSteps.size());
+            for(std::size_t j = 0; j < currentSteps.size(); j++) {
+                const auto &ship = ships[currentSteps[j]];
+                const hlt::SeedStream episode(env.seed(ship.game));
+                draws[j] = episode.substream(env.game(ship.game).turn_number).uniform(ship.entity.value);
+            }
+            auto drawTensor = torch::from_blob(draws.data(), { static_cast<long>(draws.size()), 1 });
+            auto &policy = policyCopies[copy];
+            auto modelOutput = policy.network->forward(observations.shared, observations.sharedIndex, observations.ship, emptyAction, drawTensor);
+            auto actionTensor = modelOutput.action.contiguous();
+            auto valueTensor = modelOutput.value.contiguous();
+            auto logProbTensor = modelOutput.log_prob.contiguous();
+            auto actionData = actionTensor.data<int64_t>();
+            auto valueData = valueTensor.data<float>();
+            auto logProbData = logProbTensor.data<float>();
+
+            for(std::size_t j = 0; j < currentSteps.size(); j++) {
+                const auto i = currentSteps[j];
+                currentTurn.action[i] = static_cast<uint8_t>(actionData[j]);
+                currentTurn.value[i] = valueData[j];
+                currentTurn.logProb[i] = logProbData[j];
+                currentTurn.policyVersion[i] = static_cast<int32_t>(policy.version);
+                actions[i] = actionData[j];
+            }
+        }
+
+        env.step(actions);
+
+        //If any energy was dropped off by a ship. ships now holds the next turn's ships, so count this turn's steps
+        const auto &rewards = env.rewards();
+        for(std::size_t i = 0; i < currentTurn.size(); i++) {
+            currentTurn.reward[i] = rewards[i];
+        }
+
+        //Ships come grouped by game, so each game's steps are one range of the turn
+        std::size_t firstStep = 0;
+        for(std::size_t game = 0; game < env.size(); game++) {
+            auto lastStep = firstStep;
+            while(lastStep < currentTurn.size() && currentTurn.game[lastStep] == game) {
+                lastStep++;
+            }
+            if(lastStep > firstStep) {
+                pendingRollouts[game].append(currentTurn, game, 1, firstStep, lastStep - firstStep);
+            }
+            firstStep = lastStep;
+        }
+
+        for(const auto &finished : env.finished()) {
+            Trajectory trajectory;
+            trajectory.rollouts = std::move(pendingRollouts[finished.game]);
+            pendingRollouts[finished.game] = RolloutBuffer();
+            trajectory.scores = finished.scores;
+            trajectory.gameSteps = finished.turns;
+            trajectory.seed = finished.seed;
+            trajectory.policyVersion = policyCopies[slotPolicies[finished.game]].version;
+            start_game(finished.game);
+            //Sleep while the learner trains and the queue is full, rather than spin on a core it needs
+            const auto pushed = trajectories.push(std::move(trajectory), [this] {
+                return stopping.load(std::memory_order_relaxed);
+            });
+            if(!pushed) {
+                return;
+            }
+        }
+    }
+
+    void run() {
+        //Threads torch did not start itself only pick up the intra-op count set at startup once asked to
+        at::init_num_threads();
+        //Sampling actions does not need gradients
+        torch::NoGradGuard noGrad;
+        while(!stopping.load(std::memory_order_relaxed)) {
+            step();
+        }
+    }
+
+public:
+    RolloutWorker(PolicyStore &policies, BoundedMpscQueue<Trajectory> &trajectories, std::size_t num_games, const hlt::SeedStream &seeds):
+        policies(policies),
+        trajectories(trajectories),
+        env(num_games, GAME_WIDTH, GAME_HEIGHT, NUMBER_OF_PLAYERS, seeds),
+        slotPolicies(num_games, NO_POLICY),
+        pendingRollouts(num_games)
+    {
+        for(std::size_t slot = 0; slot < num_games; slot++) {
+            start_game(slot);
+        }
+        thread = std::thread(&RolloutWorker::run, this);
+    }
+
+    RolloutWorker(const RolloutWorker &) = delete;
+    RolloutWorker &operator=(const RolloutWorker &) = delete;
+
+    ~RolloutWorker() {
+        stopping.store(true, std::memory_order_relaxed);
+        //A worker waiting for room in the queue only notices it is stopping once woken
+        trajectories.wake_producers();
+        thread.join();
+    }
+};
+
+#endif
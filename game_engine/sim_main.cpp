@@ -0,0 +1,200 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Constants.hpp"
+#include "Generator.hpp"
+#include "Halite.hpp"
+#include "Profiler.hpp"
+#include "Replay.hpp"
+#include "ScriptedBot.hpp"
+#include "SeedStream.hpp"
+
+/**
+ * Headless simulator: plays games between scripted bots on several threads, without a model, and reports games and
+ * turns per second and the distribution of each seat's score. This measures the engine on its own.
+ *
+ * Usage: halite_sim [--games M] [--threads K] [--size N] [--seed S] [--bots NAME,NAME,...]
+ * The bots are random, greedy-miner or return-when-full, one per player, for two or four players.
+ */
+
+namespace {
+
+/** The settings of a run. */
+struct Options {
+    std::size_t games = 64;    /**< The number of games to play. */
+    unsigned int threads = std::max(1u, std::thread::hardware_concurrency()); /**< The number of threads. */
+    long size = 32;            /**< The width and height of each map. */
+    std::uint64_t seed = 1;    /**< The master seed, from which every game's map and bot seeds derive. */
+    /** The bot of each seat. */
+    std::vector<hlt::BotKind> bots{hlt::BotKind::GreedyMiner, hlt::BotKind::ReturnWhenFull};
+};
+
+/** The outcome of one game. */
+struct GameResult {
+    unsigned long turns{};        /**< The number of turns played. */
+    std::vector<long> scores;     /**< The final production of each seat. */
+};
+
+/**
+ * Parse the command line.
+ * @param argc The number of arguments.
+ * @param argv The arguments.
+ * @param[out] options The settings.
+ * @return True if the arguments are valid.
+ */
+bool parse_options(int argc, char *argv[], Options &options) {
+    try {
+        for (int index = 1; index + 1 < argc; index += 2) {
+            const std::string flag = argv[index];
+            const std::string value = argv[index + 1];
+            if (flag == "--games") {
+                options.games = std::stoul(value);
+            } else if (flag == "--threads") {
+                options.threads = static_cast<unsigned int>(std::stoul(value));
+            } else if (flag == "--size") {
+                options.size = std::stol(value);
+            } else if (flag == "--seed") {
+                options.seed = std::stoull(value);
+            } else if (flag == "--bots") {
+                options.bots.clear();
+                std::istringstream names(value);
+                std::string name;
+                while (std::getline(names, name, ',')) {
+                    hlt::BotKind kind;
+                    if (!hlt::parse_bot_kind(name, kind)) {
+                        return false;
+                    }
+                    options.bots.push_back(kind);
+                }
+            } else {
+                return false;
+            }
+        }
+    } catch (const std::exception &) {
+        return false;
+    }
+    return argc % 2 == 1 && options.games > 0 && options.threads > 0 && options.size > 0
+           && (options.bots.size() == 2 || options.bots.size() == 4);
+}
+
+/**
+ * Play one game between the bots.
+ * @param options The settings.
+ * @param index The number of the game in the run.
+ * @return The outcome.
+ */
+GameResult play_game(const Options &options, std::size_t index) {
+    // Seeds depend only on the game's number, never on which thread plays it or when.
+    const hlt::SeedStream seeds(options.seed);
+    const auto seed = seeds.seed(index);
+    const auto players = options.bots.size();
+    hlt::Map map(options.size, options.size);
+    hlt::mapgen::MapParameters parameters{hlt::mapgen::MapType::Fractal, seed, options.size, options.size, players};
+    hlt::mapgen::Generator::generate(map, parameters, hlt::Constants::get());
+    hlt::GameStatistics statistics;
+    hlt::Replay replay(statistics, players, seed, map);
+    hlt::Halite game(map, statistics, replay, hlt::Constants::get());
+    game.initialize_game(static_cast<int>(players));
+    game.turn_number = 1;
+
+    std::vector<hlt::ScriptedBot> bots;
+    for (std::size_t seat = 0; seat < players; seat++) {
+        bots.emplace_back(options.bots[seat], seeds.substream(index).seed(seat));
+    }
+    hlt::TurnCommands commands(players);
+    hlt::play_game(game, bots, commands);
+    GameResult result;
+    result.turns = game.turn_number;
+    for (const auto &player_statistics : statistics.player_statistics) {
+        result.scores.push_back(player_statistics.turn_productions.back());
+    }
+    return result;
+}
+
+/**
+ * Get a percentile of sorted values, by the nearest rank.
+ * @param sorted The values, in ascending order.
+ * @param percent The percentile.
+ * @return The value.
+ */
+long percentile(const std::vector<long> &sorted, int percent) {
+    const auto rank = (sorted.size() - 1) * static_cast<std::size_t>(percent) / 100;
+    return sorted[rank];
+}
+
+}
+
+int main(int argc, char *argv[]) {
+    Options options;
+    if (!parse_options(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0] << " [--games M] [--threads K] [--size N] [--seed S]"
+                  << " [--bots NAME,NAME,...]" << std::endl
+                  << "Bots are random, greedy-miner or return-when-full, two or four of them." << std::endl;
+        return 1;
+    }
+
+    std::vector<GameResult> results(options.games);
+    std::atomic<std::size_t> next_game{0};
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned int thread = 0; thread < options.threads; thread++) {
+        threads.emplace_back([&] {
+            for (auto index = next_game++; index < options.games; index = next_game++) {
+                results[index] = play_game(options, index);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    unsigned long turns = 0;
+    const auto seats = options.bots.size();
+    std::vector<std::vector<long>> scores(seats);
+    std::vector<std::size_t> wins(seats);
+    for (const auto &result : results) {
+        turns += result.turns;
+        for (std::size_t seat = 0; seat < seats; seat++) {
+            scores[seat].push_back(result.scores[seat]);
+        }
+        // Only an outright best score counts as a win.
+        const auto best = std::max_element(result.scores.begin(), result.scores.end());
+        if (std::count(result.scores.begin(), result.scores.end(), *best) == 1) {
+            wins[best - result.scores.begin()]++;
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision(1)
+              << options.games << " games on " << options.size << "x" << options.size << " maps, "
+              << options.threads << " threads, " << elapsed.count() << " s: "
+              << options.games / elapsed.count() << " games/s, "
+              << turns / elapsed.count() << " turns/s" << std::endl;
+    std::cout << std::left << std::setw(6) << "seat" << std::setw(18) << "bot"
+              << std::right << std::setw(10) << "mean" << std::setw(8) << "min" << std::setw(8) << "p10"
+              << std::setw(8) << "p50" << std::setw(8) << "p90" << std::setw(8) << "max" << std::setw(8) << "wins"
+              << std::endl;
+    for (std::size_t seat = 0; seat < seats; seat++) {
+        auto &seat_scores = scores[seat];
+        std::sort(seat_scores.begin(), seat_scores.end());
+        double total = 0;
+        for (const auto score : seat_scores) {
+            total += score;
+        }
+        std::cout << std::left << std::setw(6) << seat << std::setw(18) << hlt::bot_name(options.bots[seat])
+                  << std::right << std::setw(10) << total / seat_scores.size()
+                  << std::setw(8) << seat_scores.front() << std::setw(8) << percentile(seat_scores, 10)
+                  << std::setw(8) << percentile(seat_scores, 50) << std::setw(8) << percentile(seat_scores, 90)
+                  << std::setw(8) << seat_scores.back() << std::setw(8) << wins[seat] << std::endl;
+    }
+    hlt::write_profile(std::cout);
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include <cmath>
+#include <vector>
+
+#include "TestCheck.hpp"
+#include "advantage.hpp"
+
+namespace {
+
+const float DISCOUNT_RATE = 0.9f;
+const float TAU = 0.8f;
+
+/** A flat batch of steps, as laid out in a rollout buffer. */
+struct Steps {
+    std::vector<uint32_t> game;
+    std::vector<int32_t> entity;
+    std::vector<float> reward;
+    std::vector<float> value;
+    std::vector<uint8_t> done;
+    std::vector<float> returns;
+    std::vector<float> advantages;
+
+    void add(uint32_t game_id, int32_t entity_id, float step_reward, float step_value, uint8_t step_done = 1) {
+        game.push_back(game_id);
+        entity.push_back(entity_id);
+        reward.push_back(step_reward);
+        value.push_back(step_value);
+        done.push_back(step_done);
+    }
+
+    void compute() {
+        returns.resize(game.size());
+        advantages.resize(game.size());
+        compute_advantages(game.size(), game.data(), entity.data(), reward.data(), value.data(), done.data(),
+                           DISCOUNT_RATE, TAU, returns.data(), advantages.data());
+    }
+};
+
+/**
+ * Compute returns and advantages of one trajectory with the textbook backward recursion.
+ * @param reward The rewards of the trajectory, in order.
+ * @param value The values of the trajectory, in order.
+ * @param[out] returns The expected returns.
+ * @param[out] advantages The expected advantages.
+ */
+void reference(const std::vector<float> &reward, const std::vector<float> &value,
+               std::vector<float> &returns, std::vector<float> &advantages) {
+    returns.assign(reward.size(), 0);
+    advantages.assign(reward.size(), 0);
+    float next_return = 0, next_advantage = 0, next_value = 0;
+    for (auto i = reward.size(); i-- > 0;) {
+        returns[i] = reward[i] + DISCOUNT_RATE * next_return;
+        advantages[i] = reward[i] + DISCOUNT_RATE * next_value - value[i] + DISCOUNT_RATE * TAU * next_advantage;
+        next_return = returns[i];
+        next_advantage = advantages[i];
+        next_value = value[i];
+    }
+}
+
+const char *const NAME = "AdvantageTest";
+
+bool close(float a, float b) {
+    return std::fabs(a - b) < 1e-5f;
+}
+
+/** A single ship matches the textbook recursion, and is not bootstrapped past its last step. */
+void test_single_trajectory() {
+    Steps steps;
+    const std::vector<float> reward{0, 1, 0, 2};
+    const std::vector<float> value{0.5f, 0.25f, 1, 0.75f};
+    for (std::size_t i = 0; i < reward.size(); i++) {
+        steps.add(0, 3, reward[i], value[i]);
+    }
+    steps.compute();
+
+    std::vector<float> returns, advantages;
+    reference(reward, value, returns, advantages);
+    for (std::size_t i = 0; i < reward.size(); i++) {
+        check(NAME, close(steps.returns[i], returns[i]), "single trajectory return");
+        check(NAME, close(steps.advantages[i], advantages[i]), "single trajectory advantage");
+    }
+    check(NAME, close(steps.advantages[3], 2 - 0.75f), "last step bootstraps from nothing");
+}
+
+/** Ships sharing turns are separate trajectories, including one that dies early. */
+void test_interleaved_ships() {
+    Steps steps;
+    const std::vector<float> reward_a{1, 0, 3}, value_a{0.1f, 0.2f, 0.3f};
+    const std::vector<float> reward_b{0, 5}, value_b{0.4f, 0.5f};
+    steps.add(0, 1, reward_a[0], value_a[0]);
+    steps.add(0, 2, reward_b[0], value_b[0]);
+    steps.add(0, 1, reward_a[1], value_a[1]);
+    steps.add(0, 2, reward_b[1], value_b[1]);
+    steps.add(0, 1, reward_a[2], value_a[2]);
+    steps.compute();
+
+    std::vector<float> returns_a, advantages_a, returns_b, advantages_b;
+    reference(reward_a, value_a, returns_a, advantages_a);
+    reference(reward_b, value_b, returns_b, advantages_b);
+    const std::size_t a[] = {0, 2, 4}, b[] = {1, 3};
+    for (std::size_t i = 0; i < 3; i++) {
+        check(NAME, close(steps.returns[a[i]], returns_a[i]), "interleaved ship A return");
+        check(NAME, close(steps.advantages[a[i]], advantages_a[i]), "interleaved ship A advantage");
+    }
+    for (std::size_t i = 0; i < 2; i++) {
+        check(NAME, close(steps.returns[b[i]], returns_b[i]), "interleaved ship B return");
+        check(NAME, close(steps.advantages[b[i]], advantages_b[i]), "interleaved ship B advantage");
+    }
+}
+
+/** The same entity ID in consecutive games, and a step marked done, both end a trajectory. */
+void test_boundaries() {
+    Steps steps;
+    steps.add(0, 0, 1, 0.5f);
+    steps.add(0, 0, 2, 0.5f);
+    steps.add(1, 0, 4, 0.5f);
+    steps.add(1, 0, 8, 0.5f, 0);
+    steps.add(1, 0, 16, 0.5f);
+    steps.compute();
+
+    check(NAME, close(steps.returns[1], 2), "last step of a game is not bootstrapped from the next game");
+    check(NAME, close(steps.advantages[1], 2 - 0.5f), "last step of a game has no next value");
+    check(NAME, close(steps.returns[0], 1 + DISCOUNT_RATE * 2), "game 0 return");
+    check(NAME, close(steps.returns[3], 8), "done step is not bootstrapped");
+    check(NAME, close(steps.returns[2], 4 + DISCOUNT_RATE * 8), "step before done bootstraps from it");
+    check(NAME, close(steps.returns[4], 16), "step after done starts a new trajectory");
+}
+
+/** Normalized advantages have zero mean and unit standard deviation. */
+void test_normalization() {
+    std::vector<float> advantages{1, 2, 3, 4, 10};
+    normalize_advantages(advantages.size(), advantages.data());
+    double sum = 0, sum_of_squares = 0;
+    for (auto advantage : advantages) {
+        sum += advantage;
+        sum_of_squares += advantage * advantage;
+    }
+    check(NAME, std::fabs(sum / advantages.size()) < 1e-5, "normalized mean");
+    check(NAME, std::fabs(sum_of_squares / advantages.size() - 1) < 1e-4, "normalized variance");
+
+    std::vector<float> constant{3, 3, 3};
+    normalize_advantages(constant.size(), constant.data());
+    check(NAME, constant[0] == 0 && constant[2] == 0, "constant advantages normalize to zero");
+}
+
+}
+
+void advantage_test() {
+    test_single_trajectory();
+    test_interleaved_ships();
+    test_boundaries();
+    test_normalization();
+}
@@ -0,0 +1,101 @@
+#include <cstdlib>
+#include <vector>
+
+#include "Bitboard.hpp"
+#include "TestCheck.hpp"
+
+namespace {
+
+const char *const NAME = "BitboardTest";
+
+/** The distance between two cells on a torus, as Map::distance computes it. */
+hlt::dimension_type distance(const hlt::Location &a, const hlt::Location &b, hlt::dimension_type width,
+                             hlt::dimension_type height) {
+    const auto dx = std::abs(a.x - b.x);
+    const auto dy = std::abs(a.y - b.y);
+    return std::min(dx, width - dx) + std::min(dy, height - dy);
+}
+
+/** Expanding matches a scan of every cell within the radius, including on maps smaller than the neighborhood. */
+void test_expand() {
+    const hlt::dimension_type sizes[][2] = {{32, 32}, {64, 64}, {40, 17}, {5, 3}, {1, 4}, {64, 1}};
+    for (const auto &size : sizes) {
+        const auto width = size[0], height = size[1];
+        std::vector<hlt::Location> cells{{0, 0}, {width - 1, height / 2}, {width / 2, height - 1}};
+        for (hlt::dimension_type radius = 0; radius <= 3; radius++) {
+            hlt::Bitboard board(width, height);
+            for (const auto &cell : cells) {
+                board.set(cell);
+            }
+            board.expand(radius);
+
+            bool matches = true;
+            long expected = 0;
+            for (hlt::dimension_type y = 0; y < height; y++) {
+                for (hlt::dimension_type x = 0; x < width; x++) {
+                    bool near = false;
+                    for (const auto &cell : cells) {
+                        near = near || distance({x, y}, cell, width, height) <= radius;
+                    }
+                    expected += near;
+                    matches = matches && board.test({x, y}) == near;
+                }
+            }
+            check(NAME, matches, "expanded cells are those within the radius");
+            check(NAME, board.count() == expected, "expanded count");
+            check(NAME, width == hlt::Bitboard::MAX_WIDTH || (board.row(0) >> width) == 0, "no bits past the width");
+        }
+    }
+}
+
+/** Shifting wraps cells around both edges. */
+void test_shift() {
+    hlt::Bitboard board(10, 6), shifted;
+    board.set({9, 5});
+    board.set({0, 0});
+    board.shift(1, -1, shifted);
+    check(NAME, shifted.count() == 2, "shift keeps every cell");
+    check(NAME, shifted.test({0, 4}), "shift wraps east past the right edge");
+    check(NAME, shifted.test({1, 5}), "shift wraps north past the top edge");
+
+    board.shift(-21, 13, shifted);
+    check(NAME, shifted.test({8, 0}) && shifted.test({9, 1}), "shift by more than the map size");
+}
+
+/** A board exports as a row-major plane. */
+void test_write_plane() {
+    hlt::Bitboard board(3, 2);
+    board.set({2, 0});
+    board.set({1, 1});
+    float plane[6];
+    board.write_plane(plane, 0.5f);
+    const float expected[6] = {0, 0, 0.5f, 0, 0.5f, 0};
+    bool matches = true;
+    for (int i = 0; i < 6; i++) {
+        matches = matches && plane[i] == expected[i];
+    }
+    check(NAME, matches, "plane values");
+
+    // Rows copied out of the board write the same plane.
+    const hlt::Bitboard::row_type rows[2] = {board.row(0), board.row(1)};
+    float copied[6];
+    hlt::Bitboard::write_plane(rows, 3, 2, copied, 0.5f);
+    matches = true;
+    for (int i = 0; i < 6; i++) {
+        matches = matches && copied[i] == expected[i];
+    }
+    check(NAME, matches, "plane values from copied rows");
+
+    board.reset({2, 0});
+    check(NAME, !board.test({2, 0}) && board.any(), "reset removes one cell");
+    board.clear();
+    check(NAME, !board.any(), "clear removes every cell");
+}
+
+}
+
+void bitboard_test() {
+    test_expand();
+    test_shift();
+    test_write_plane();
+}
@@ -0,0 +1,110 @@
+#include <vector>
+
+#include "CaptureField.hpp"
+#include "TestCheck.hpp"
+#include "TestGame.hpp"
+
+namespace {
+
+const char *const NAME = "CaptureFieldTest";
+
+/** Count a player's ships within a radius of a cell by checking the distance to every ship, each counted once. */
+unsigned long brute_force_count(const hlt::Halite &game, hlt::Player::id_type player, hlt::Location location,
+                                hlt::dimension_type radius) {
+    unsigned long count = 0;
+    for (const auto &entity : game.store.entities) {
+        if (entity.owner == player && game.map.distance(location, entity.location) <= radius) {
+            count++;
+        }
+    }
+    return count;
+}
+
+/** The per-cell counts agree with the brute-force diamond count, on maps small enough for the diamond to wrap. */
+void test_matches_brute_force() {
+    static constexpr int TURNS = 25;
+    bool matches = true;
+    for (const long size : {6, 8, 12, 32}) {
+        for (const unsigned long players : {2ul, 4ul}) {
+            TestGame game(3, size, players);
+            auto &halite = *game.halite;
+            hlt::TurnCommands commands;
+            hlt::CaptureField field;
+            for (int turn = 0; turn < TURNS; turn++) {
+                play_turn(halite, commands);
+                for (hlt::dimension_type radius = 0; radius <= 5; radius++) {
+                    field.compute(halite.store, halite.map, radius);
+                    for (const auto &[player_id, _] : halite.store.players) {
+                        for (hlt::dimension_type y = 0; y < size; y++) {
+                            for (hlt::dimension_type x = 0; x < size; x++) {
+                                matches = matches && field.count(player_id, {x, y})
+                                                     == brute_force_count(halite, player_id, {x, y}, radius);
+                            }
+                        }
+                    }
+                }
+            }
+            check(NAME, halite.store.entities.size() > players, "too few ships to count");
+        }
+    }
+    check(NAME, matches, "the field differs from the brute-force count");
+}
+
+/**
+ * A ship surrounded by two opponents with the same number of ships nearby goes to the opponent with the lower ID.
+ * @param victim The owner of the surrounded ship.
+ * @param first The opponent with ships on one side.
+ * @param second The opponent with ships on the other side.
+ * @return The owner of the ship after the turn, or -1 if it was not captured.
+ */
+long capture_tie(long victim, long first, long second) {
+    static constexpr unsigned long PLAYERS = 4;
+    hlt::GameConfig config = hlt::Constants::get();
+    config.CAPTURE_ENABLED = true;
+    config.CAPTURE_RADIUS = 2;
+    config.SHIPS_ABOVE_FOR_CAPTURE = 1;
+    TestGame game(5, 32, PLAYERS, config);
+    auto &halite = *game.halite;
+
+    // A row of five free cells: two of the first opponent's ships, the victim's, and two of the second's. Each
+    // opponent's outer ship is out of range of the other opponent, so only the middle ship can be captured.
+    hlt::Location center{0, 0};
+    bool found = false;
+    for (hlt::dimension_type y = 0; y < 32 && !found; y++) {
+        for (hlt::dimension_type x = 2; x < 30 && !found; x++) {
+            found = true;
+            for (hlt::dimension_type dx = -2; dx <= 2; dx++) {
+                found = found && halite.map.at(hlt::Location{x + dx, y}).owner == hlt::Player::None;
+            }
+            center = {x, y};
+        }
+    }
+    const std::pair<long, hlt::dimension_type> ships[] = {{first, -2}, {first, -1}, {victim, 0},
+                                                          {second, 1}, {second, 2}};
+    for (const auto &[owner, dx] : ships) {
+        const hlt::Location location{center.x + dx, center.y};
+        halite.map.at(location).entity = halite.store.new_entity(0, hlt::Player::id_type(owner), location).id;
+    }
+
+    hlt::TurnCommands commands;
+    commands.clear(PLAYERS);
+    halite.process_turn(commands);
+    const auto &cell = halite.map.at(center);
+    const auto owner = halite.store.get_entity(cell.entity).owner.value;
+    return owner == victim ? -1 : owner;
+}
+
+/** Ties between opponents go to the lowest player ID, whichever side their ships are on. */
+void test_ties_go_to_lowest_id() {
+    check(NAME, capture_tie(0, 1, 2) == 1, "tie between players 1 and 2 did not go to player 1");
+    check(NAME, capture_tie(0, 2, 1) == 1, "tie between players 2 and 1 did not go to player 1");
+    check(NAME, capture_tie(1, 3, 2) == 2, "tie between players 3 and 2 did not go to player 2");
+    check(NAME, capture_tie(3, 2, 0) == 0, "tie between players 2 and 0 did not go to player 0");
+}
+
+}
+
+void capture_field_test() {
+    test_matches_brute_force();
+    test_ties_go_to_lowest_id();
+}
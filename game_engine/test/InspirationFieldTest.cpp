@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <vector>
+
+#include "InspirationField.hpp"
+#include "TestCheck.hpp"
+#include "TestGame.hpp"
+
+namespace {
+
+const char *const NAME = "InspirationFieldTest";
+
+/**
+ * Count the other players' ships near a cell by scanning the square window around it, as update_inspiration did
+ * before the field. On maps narrower than the window, offsets that wrap onto the same cell count its ship again.
+ */
+unsigned long scan_opponents(const hlt::Halite &game, hlt::Player::id_type owner, hlt::Location location,
+                             hlt::dimension_type radius) {
+    const auto width = game.map.width, height = game.map.height;
+    unsigned long opponents = 0;
+    for (auto dx = -radius; dx <= radius; dx++) {
+        for (auto dy = -radius; dy <= radius; dy++) {
+            const hlt::Location scanned{(((location.x + dx) % width) + width) % width,
+                                        (((location.y + dy) % height) + height) % height};
+            const auto &cell = game.map.at(scanned);
+            if (cell.entity == hlt::Entity::None || game.map.distance(location, scanned) > radius) {
+                continue;
+            }
+            if (game.store.get_entity(cell.entity).owner != owner) {
+                opponents++;
+            }
+        }
+    }
+    return opponents;
+}
+
+/** Whether the field gives the scan's count at every cell, for every player. */
+bool matches_scan(const hlt::InspirationField &field, const hlt::Halite &game, hlt::dimension_type radius) {
+    for (const auto &[player_id, _] : game.store.players) {
+        for (hlt::dimension_type y = 0; y < game.map.height; y++) {
+            for (hlt::dimension_type x = 0; x < game.map.width; x++) {
+                if (field.opponents(player_id, {x, y}) != scan_opponents(game, player_id, {x, y}, radius)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/** The IDs of the ships in a game, in ID order. */
+std::vector<long> ship_ids(const hlt::Halite &game) {
+    std::vector<long> ids;
+    game.store.entities.for_each_in_id_order([&ids](const hlt::Entity &entity) {
+        ids.push_back(entity.id.value);
+    });
+    return ids;
+}
+
+/**
+ * One field, synced after every turn of a game, matches the scan throughout: as ships spawn, move and die, and
+ * after the game is restored to an earlier turn.
+ * @param seed The seed of the map.
+ * @param size The width and height of the map.
+ * @param players The number of players.
+ * @param radius The inspiration radius.
+ */
+void check_game(unsigned int seed, long size, unsigned long players, hlt::dimension_type radius) {
+    static constexpr int TURNS = 30;
+    static constexpr int SNAPSHOT_TURN = 15;
+    auto config = TestGame::fleet_config();
+    config.INSPIRATION_RADIUS = radius;
+    TestGame game(seed, size, players, config);
+    auto &halite = *game.halite;
+    hlt::InspirationField field;
+    hlt::TurnCommands commands;
+    hlt::GameSnapshot snapshot;
+
+    bool matches = true, spawned = false, died = false;
+    auto previous = ship_ids(halite);
+    for (int turn = 0; turn < TURNS; turn++) {
+        if (turn == SNAPSHOT_TURN) {
+            halite.snapshot(snapshot);
+        }
+        play_turn(halite, commands);
+        field.sync(halite.store, halite.map, radius);
+        matches = matches && matches_scan(field, halite, radius);
+
+        const auto current = ship_ids(halite);
+        spawned = spawned || (!current.empty() && (previous.empty() || current.back() > previous.back()));
+        died = died || std::any_of(previous.begin(), previous.end(), [&current](long id) {
+            return !std::binary_search(current.begin(), current.end(), id);
+        });
+        previous = current;
+    }
+    check(NAME, spawned && died, "the game had no spawns or no deaths to sync");
+    check(NAME, matches, "the synced field differs from the scan");
+
+    halite.restore(snapshot);
+    field.sync(halite.store, halite.map, radius);
+    bool restored = matches_scan(field, halite, radius);
+    for (int turn = 0; turn < 5; turn++) {
+        play_turn(halite, commands);
+        field.sync(halite.store, halite.map, radius);
+        restored = restored && matches_scan(field, halite, radius);
+    }
+    check(NAME, restored, "the field differs from the scan after a restore");
+}
+
+/** The field matches the old scan, including on maps narrower than the window, where wrapped offsets repeat. */
+void test_matches_scan() {
+    for (const unsigned int seed : {1u, 2u}) {
+        for (const unsigned long players : {2ul, 4ul}) {
+            check_game(seed, 6, players, 4);
+            check_game(seed, 8, players, 4);
+            check_game(seed, 8, players, 5);
+            check_game(seed, 12, players, 4);
+            check_game(seed, 32, players, 4);
+        }
+    }
+}
+
+/** On a map narrower than the window, a ship whose offsets wrap onto the same cell is counted for each of them. */
+void test_wrapped_offsets_repeat() {
+    auto config = TestGame::fleet_config();
+    TestGame game(1, 6, 2, config);
+    auto &halite = *game.halite;
+    hlt::TurnCommands commands;
+    while (halite.store.entities.empty()) {
+        play_turn(halite, commands);
+    }
+    hlt::InspirationField field;
+    field.sync(halite.store, halite.map, 4);
+    const auto &ship = *halite.store.entities.begin();
+    const hlt::Player::id_type other(ship.owner.value == 0 ? 1 : 0);
+    // On a 6x6 map, dx = -3 and dx = 3 reach the same column, and so on, so the ship's own cell is reached once
+    // but cells three columns away are reached twice.
+    const hlt::Location across{(ship.location.x + 3) % 6, ship.location.y};
+    check(NAME, field.opponents(other, ship.location) >= 1, "the ship is not counted at its own cell");
+    check(NAME, field.opponents(other, across) == scan_opponents(halite, other, across, 4)
+                && scan_opponents(halite, other, across, 4) >= 2, "a wrapped offset is not counted again");
+}
+
+}
+
+void inspiration_field_test() {
+    test_matches_scan();
+    test_wrapped_offsets_repeat();
+}
@@ -0,0 +1,155 @@
+#include <vector>
+
+#include "DestinationGrid.hpp"
+#include "TestCheck.hpp"
+#include "TestGame.hpp"
+
+namespace {
+
+const char *const NAME = "MoveResolutionTest";
+
+constexpr unsigned long PLAYERS = 2;
+
+/** A game with no ships yet, and ships placed by hand on cells no player owns. */
+struct MoveGame {
+    TestGame game{17, 32, PLAYERS};
+    hlt::Halite &halite = *game.halite;
+    hlt::TurnCommands commands;
+    hlt::Location center{0, 0};
+
+    MoveGame() {
+        // The center and its neighbors, far from every factory.
+        for (hlt::dimension_type y = 2; y < 30; y++) {
+            for (hlt::dimension_type x = 2; x < 30; x++) {
+                bool free = true;
+                for (hlt::dimension_type dy = -2; dy <= 2; dy++) {
+                    for (hlt::dimension_type dx = -2; dx <= 2; dx++) {
+                        free = free && halite.map.at(hlt::Location{x + dx, y + dy}).owner == hlt::Player::None;
+                    }
+                }
+                if (free) {
+                    center = {x, y};
+                    commands.clear(PLAYERS);
+                    return;
+                }
+            }
+        }
+    }
+
+    /** Place a ship, returning its ID. */
+    long place(long owner, hlt::dimension_type dx, hlt::dimension_type dy, hlt::energy_type energy = 100) {
+        const hlt::Location location{center.x + dx, center.y + dy};
+        const auto id = halite.store.new_entity(energy, hlt::Player::id_type(owner), location).id;
+        halite.map.at(location).entity = id;
+        return id.value;
+    }
+
+    /** Command a ship. */
+    void order(long owner, long ship, hlt::AgentAction action) {
+        commands.add(owner, {ship, action});
+    }
+
+    /** Play the turn. */
+    void play() {
+        halite.process_turn(commands);
+        halite.turn_number++;
+    }
+
+    /** Whether a ship is still in play. */
+    bool alive(long ship) const {
+        return halite.store.entities.contains(hlt::Entity::id_type(ship));
+    }
+
+    /** Whether a ship is on a cell, relative to the center. */
+    bool at(long ship, hlt::dimension_type dx, hlt::dimension_type dy) const {
+        const hlt::Location location{center.x + dx, center.y + dy};
+        return alive(ship) && halite.store.get_entity(hlt::Entity::id_type(ship)).location == location
+               && halite.map.at(location).entity.value == ship;
+    }
+};
+
+/** Two ships moving into the same cell from opposite sides both sink; two ships swapping cells pass each other. */
+void test_head_on() {
+    MoveGame converge;
+    const auto west = converge.place(0, -1, 0), east = converge.place(1, 1, 0);
+    const auto cell_energy = converge.halite.map.at(converge.center).energy;
+    converge.order(0, west, hlt::AgentAction::East);
+    converge.order(1, east, hlt::AgentAction::West);
+    converge.play();
+    check(NAME, !converge.alive(west) && !converge.alive(east), "ships meeting head-on survived");
+    check(NAME, converge.halite.map.at(converge.center).entity == hlt::Entity::None, "the collision cell is occupied");
+    check(NAME, converge.halite.map.at(converge.center).energy >= cell_energy + 200,
+          "the ships' cargo was not dropped on the cell");
+
+    MoveGame swap;
+    const auto left = swap.place(0, 0, 0), right = swap.place(1, 1, 0);
+    swap.order(0, left, hlt::AgentAction::East);
+    swap.order(1, right, hlt::AgentAction::West);
+    swap.play();
+    check(NAME, swap.at(left, 1, 0) && swap.at(right, 0, 0), "ships swapping cells did not pass each other");
+}
+
+/** Two ships of one player moving into the same cell both sink, and the player stays in the game. */
+void test_self_collision() {
+    MoveGame game;
+    const auto north = game.place(0, 0, -1), south = game.place(0, 0, 1), bystander = game.place(0, 2, 2);
+    game.order(0, north, hlt::AgentAction::South);
+    game.order(0, south, hlt::AgentAction::North);
+    game.play();
+    check(NAME, !game.alive(north) && !game.alive(south), "self-colliding ships survived");
+    check(NAME, game.at(bystander, 2, 2), "a ship that stayed was moved");
+    check(NAME, !game.halite.store.get_player(hlt::Player::id_type(0)).terminated,
+          "a self collision removed the player");
+    const auto &self_collided = game.halite.store.selfCollidedEntities;
+    check(NAME, self_collided.size() == 2, "self-collided ships were not recorded");
+}
+
+/** A cell can take MAX_ARRIVALS ships, one from each neighbor and one that stayed, and they all sink. */
+void test_full_cell() {
+    static_assert(hlt::DestinationGrid::MAX_ARRIVALS == 5, "one arrival per neighbor, plus one that stayed");
+    MoveGame game;
+    const std::vector<long> ships{game.place(0, 0, 0), game.place(0, 0, -1), game.place(1, 1, 0),
+                                  game.place(1, 0, 1), game.place(0, -1, 0)};
+    game.order(0, ships[1], hlt::AgentAction::South);
+    game.order(1, ships[2], hlt::AgentAction::West);
+    game.order(1, ships[3], hlt::AgentAction::North);
+    game.order(0, ships[4], hlt::AgentAction::East);
+    game.play();
+    bool sunk = true;
+    for (const auto ship : ships) {
+        sunk = sunk && !game.alive(ship);
+    }
+    check(NAME, sunk, "ships on a full cell survived");
+}
+
+/**
+ * A second command for a ship would be a sixth arrival at a full cell. The transaction refuses it before moves
+ * are resolved, so the player is removed and the other player's ships collide as usual.
+ */
+void test_duplicate_command() {
+    MoveGame game;
+    const auto staying = game.place(1, 0, 0), north = game.place(0, 0, -1), east = game.place(1, 1, 0),
+               south = game.place(1, 0, 1), west = game.place(1, -1, 0);
+    game.order(0, north, hlt::AgentAction::South);
+    game.order(0, north, hlt::AgentAction::South);
+    game.order(1, east, hlt::AgentAction::West);
+    game.order(1, south, hlt::AgentAction::North);
+    game.order(1, west, hlt::AgentAction::East);
+    game.play();
+    check(NAME, game.halite.store.get_player(hlt::Player::id_type(0)).terminated,
+          "a player commanding a ship twice stayed in the game");
+    check(NAME, !game.alive(north), "the removed player's ship is still in play");
+    check(NAME, !game.alive(staying) && !game.alive(east) && !game.alive(south) && !game.alive(west),
+          "the other player's colliding ships survived");
+    check(NAME, !game.halite.store.get_player(hlt::Player::id_type(1)).terminated,
+          "the other player was removed");
+}
+
+}
+
+void move_resolution_test() {
+    test_head_on();
+    test_self_collision();
+    test_full_cell();
+    test_duplicate_command();
+}
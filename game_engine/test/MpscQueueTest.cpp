@@ -0,0 +1,59 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "TestCheck.hpp"
+#include "../mpsc_queue.hpp"
+
+namespace {
+
+const char *const NAME = "MpscQueueTest";
+
+/** A producer blocked on a full queue gets its item in once the consumer pops, behind the items already queued. */
+void test_push_waits_for_room() {
+    BoundedMpscQueue<std::vector<int>> queue(2);
+    check(NAME, queue.try_push({1}) && queue.try_push({2}), "the queue takes items up to its capacity");
+    check(NAME, !queue.try_push({3}), "a full queue refuses items");
+
+    std::atomic<bool> pushed{false};
+    std::thread producer([&] {
+        pushed = queue.push({3}, [] { return false; });
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    check(NAME, !pushed, "push waits while the queue is full");
+
+    std::vector<int> value;
+    check(NAME, queue.try_pop(value) && value == std::vector<int>{1}, "the oldest item comes out first");
+    producer.join();
+    check(NAME, pushed, "push completes once there is room");
+    check(NAME, queue.try_pop(value) && value == std::vector<int>{2}, "queued items keep their order");
+    check(NAME, queue.try_pop(value) && value == std::vector<int>{3}, "the waiting item comes last");
+    check(NAME, !queue.try_pop(value), "the queue is empty again");
+}
+
+/** A producer blocked on a full queue gives up when woken with its stop condition set, keeping its item. */
+void test_push_stops() {
+    BoundedMpscQueue<std::vector<int>> queue(2);
+    check(NAME, queue.try_push({0}) && queue.try_push({1}), "the queue fills up");
+
+    std::atomic<bool> stopping{false};
+    bool pushed = true;
+    std::vector<int> item{2};
+    std::thread producer([&] {
+        pushed = queue.push(std::move(item), [&] { return stopping.load(); });
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    stopping = true;
+    queue.wake_producers();
+    producer.join();
+    check(NAME, !pushed, "push gives up when asked to stop");
+    check(NAME, item == std::vector<int>{2}, "an item that was not queued is not moved from");
+}
+
+}
+
+void mpsc_queue_test() {
+    test_push_waits_for_room();
+    test_push_stops();
+}
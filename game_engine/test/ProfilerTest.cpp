@@ -0,0 +1,48 @@
+#include <sstream>
+
+#include "Profiler.hpp"
+#include "TestCheck.hpp"
+
+namespace {
+
+const char *const NAME = "ProfilerTest";
+
+/** Percentiles come out within one bucket, which is at most 1/8 of the value, of the exact ones. */
+void test_percentiles() {
+    hlt::TickHistogram histogram;
+    check(NAME, histogram.percentile(50) == 0, "empty histogram has a percentile");
+    for (uint64_t ticks = 1; ticks <= 1000; ticks++) {
+        histogram.add(ticks);
+    }
+    check(NAME, histogram.count() == 1000, "wrong count");
+    const auto p50 = histogram.percentile(50), p99 = histogram.percentile(99);
+    check(NAME, p50 <= 500 && p50 * 8 >= 500 * 7, "p50 too far from 500");
+    check(NAME, p99 <= 990 && p99 * 8 >= 990 * 7, "p99 too far from 990");
+    check(NAME, histogram.percentile(0) == 1, "small durations are not exact");
+
+    hlt::TickHistogram huge;
+    huge.add(~uint64_t{0});
+    check(NAME, huge.percentile(100) >= uint64_t{1} << 63U, "largest duration lost");
+
+    hlt::TickHistogram merged;
+    merged.merge(histogram);
+    merged.merge(huge);
+    check(NAME, merged.count() == 1001 && merged.percentile(50) == p50, "merge changed the distribution");
+}
+
+/** Recorded phases show up in the summary under their map size. */
+void test_summary() {
+    hlt::record_phase(hlt::Phase::Mining, 40, 48, 1234);
+    std::ostringstream summary;
+    hlt::write_profile(summary);
+    const auto text = summary.str();
+    check(NAME, text.find("40x48") != std::string::npos, "map size missing from the summary");
+    check(NAME, text.find("mining") != std::string::npos, "phase missing from the summary");
+}
+
+}
+
+void profiler_test() {
+    test_percentiles();
+    test_summary();
+}
@@ -0,0 +1,68 @@
+#include <vector>
+
+#include "ScriptedBot.hpp"
+#include "TestCheck.hpp"
+#include "TestGame.hpp"
+
+namespace {
+
+const char *const NAME = "ScriptedBotTest";
+
+/** Every bot gives only legal commands through a whole game, and the miners bring energy home. */
+void test_full_game() {
+    const std::vector<hlt::BotKind> kinds{hlt::BotKind::Random, hlt::BotKind::GreedyMiner,
+                                          hlt::BotKind::ReturnWhenFull, hlt::BotKind::GreedyMiner};
+    TestGame game(21, 32, kinds.size(), hlt::Constants::get());
+    auto &halite = *game.halite;
+
+    std::vector<hlt::ScriptedBot> bots;
+    for (std::size_t seat = 0; seat < kinds.size(); seat++) {
+        bots.emplace_back(kinds[seat], static_cast<unsigned int>(seat));
+    }
+    hlt::TurnCommands commands;
+    hlt::play_game(halite, bots, commands);
+
+    bool none_terminated = true;
+    for (const auto &[player_id, player] : halite.store.players) {
+        none_terminated = none_terminated && !player.terminated;
+    }
+    check(NAME, none_terminated, "no bot was kicked out for an illegal command");
+    check(NAME, halite.store.get_player(hlt::Player::id_type(1)).total_energy_deposited > 0,
+          "the greedy miner drops off energy");
+    check(NAME, halite.store.get_player(hlt::Player::id_type(2)).total_energy_deposited > 0,
+          "the return-when-full miner drops off energy");
+}
+
+/** A game stops at its own turn limit, scaled down for a small map, and not at the global default. */
+void test_turn_limit() {
+    const std::vector<hlt::BotKind> kinds{hlt::BotKind::GreedyMiner, hlt::BotKind::ReturnWhenFull};
+    TestGame game(5, 32, kinds.size(), hlt::Constants::get());
+    auto &halite = *game.halite;
+    check(NAME, halite.config.MAX_TURNS < hlt::Constants::get().MAX_TURNS, "a 32x32 map has a shorter game");
+
+    std::vector<hlt::ScriptedBot> bots;
+    for (std::size_t seat = 0; seat < kinds.size(); seat++) {
+        bots.emplace_back(kinds[seat], static_cast<unsigned int>(seat));
+    }
+    hlt::TurnCommands commands;
+    hlt::play_game(halite, bots, commands);
+    check(NAME, halite.turn_number <= halite.config.MAX_TURNS, "the game never runs past its own turn limit");
+}
+
+/** Names round-trip, and unknown names are refused. */
+void test_names() {
+    for (const auto kind : {hlt::BotKind::Random, hlt::BotKind::GreedyMiner, hlt::BotKind::ReturnWhenFull}) {
+        hlt::BotKind parsed;
+        check(NAME, hlt::parse_bot_kind(hlt::bot_name(kind), parsed) && parsed == kind, "bot names round-trip");
+    }
+    hlt::BotKind parsed;
+    check(NAME, !hlt::parse_bot_kind("model", parsed), "unknown bot names are refused");
+}
+
+}
+
+void scripted_bot_test() {
+    test_full_game();
+    test_turn_limit();
+    test_names();
+}
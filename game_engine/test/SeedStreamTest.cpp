@@ -0,0 +1,52 @@
+#include <algorithm>
+#include <vector>
+
+#include "SeedStream.hpp"
+#include "TestCheck.hpp"
+#include "vec_env.hpp"
+
+namespace {
+
+const char *const NAME = "SeedStreamTest";
+
+/** The stream is SplitMix64, and the same master seed always gives the same values. */
+void test_determinism() {
+    check(NAME, hlt::split_mix(0) == 0xe220a8397b1dcdafULL, "split_mix differs from the reference SplitMix64");
+    const hlt::SeedStream first(42), second(42), other(43);
+    check(NAME, first.at(7) == second.at(7), "same master seed gave different values");
+    check(NAME, first.substream(3).seed(5) == second.substream(3).seed(5), "same substream gave different seeds");
+    check(NAME, first.at(7) != other.at(7), "different master seeds gave the same value");
+}
+
+/** Seeds do not repeat, substreams are apart from each other and from their parent, and uniforms lie in [0, 1). */
+void test_independence() {
+    const hlt::SeedStream stream(1);
+    std::vector<unsigned int> seeds;
+    for (uint64_t index = 0; index < 1000; index++) {
+        seeds.push_back(stream.seed(index));
+        const auto uniform = stream.uniform(index);
+        check(NAME, uniform >= 0.0f && uniform < 1.0f, "uniform outside [0, 1)");
+    }
+    std::sort(seeds.begin(), seeds.end());
+    check(NAME, std::adjacent_find(seeds.begin(), seeds.end()) == seeds.end(), "seeds repeated");
+
+    check(NAME, stream.substream(0).at(0) != stream.substream(1).at(0), "substreams coincide");
+    check(NAME, stream.substream(2).at(0) != stream.at(2), "substream coincides with its parent");
+}
+
+/** A game slot plays the same seeds however many slots the environment has. */
+void test_vec_env_slots() {
+    const hlt::SeedStream seeds(7);
+    VecHaliteEnv two(2, 32, 32, 2, seeds);
+    VecHaliteEnv four(4, 32, 32, 2, seeds);
+    check(NAME, two.seed(0) == four.seed(0) && two.seed(1) == four.seed(1), "slot seeds depend on the number of games");
+    check(NAME, two.seed(0) != two.seed(1), "slots share a seed");
+}
+
+}
+
+void seed_stream_test() {
+    test_determinism();
+    test_independence();
+    test_vec_env_slots();
+}
@@ -0,0 +1,83 @@
+#include <map>
+#include <random>
+#include <vector>
+
+#include "SlotMap.hpp"
+#include "TestCheck.hpp"
+
+namespace {
+
+const char *const NAME = "SlotMapTest";
+
+/** A stored object, with a value to tell copies apart. */
+struct Item : Enumerated<Item> {
+    long energy;
+
+    Item(long id, long energy) : Enumerated(id_type(id)), energy(energy) {}
+};
+
+/** Random insertions and removals agree with an ordered map, in lookups and in ID order. */
+void test_against_map() {
+    SlotMap<Item> slots;
+    std::map<long, long> expected;
+    std::mt19937 rng(3);
+    long next_id = 0;
+    bool lookups = true, ordered = true;
+    for (int step = 0; step < 5000; step++) {
+        if (expected.empty() || rng() % 3 != 0) {
+            const auto id = next_id++;
+            const auto energy = static_cast<long>(rng() % 1000);
+            slots.insert(Item(id, energy));
+            expected[id] = energy;
+        } else {
+            auto victim = expected.begin();
+            std::advance(victim, static_cast<long>(rng() % expected.size()));
+            slots.erase(Item::id_type(victim->first));
+            expected.erase(victim);
+        }
+        for (long id = next_id - 4; id < next_id; id++) {
+            const auto *found = slots.find(Item::id_type(id));
+            const auto entry = expected.find(id);
+            lookups = lookups && (found == nullptr) == (entry == expected.end())
+                      && (found == nullptr || found->energy == entry->second);
+        }
+    }
+    std::vector<long> in_id_order;
+    slots.for_each_in_id_order([&in_id_order](const Item &item) {
+        in_id_order.push_back(item.id.value);
+    });
+    auto entry = expected.begin();
+    for (const auto id : in_id_order) {
+        ordered = ordered && entry != expected.end() && entry++->first == id;
+    }
+    check(NAME, lookups, "lookups disagree with the map");
+    check(NAME, ordered && entry == expected.end(), "ID order disagrees with the map");
+    check(NAME, slots.size() == expected.size(), "wrong size");
+}
+
+/** A long run of short-lived objects keeps the slot table to the span of live IDs. */
+void test_bounded_slots() {
+    SlotMap<Item> slots;
+    slots.insert(Item(0, 0));
+    for (long id = 1; id < 100000; id++) {
+        slots.insert(Item(id, 0));
+        slots.erase(Item::id_type(id));
+        if (id == 50000) {
+            slots.erase(Item::id_type(0));
+        }
+    }
+    check(NAME, slots.empty(), "objects left over");
+    check(NAME, slots.slot_count() < 100000 - 50000, "the slot table kept every ID issued");
+    check(NAME, !slots.contains(Item::id_type(0)) && !slots.contains(Item::id_type(99999)),
+          "removed IDs are still present");
+    slots.insert(Item(100000, 7));
+    check(NAME, slots.at(Item::id_type(100000)).energy == 7 && slots.slot_count() == 1,
+          "insertion after emptying");
+}
+
+}
+
+void slot_map_test() {
+    test_against_map();
+    test_bounded_slots();
+}
@@ -0,0 +1,107 @@
+#include <vector>
+
+#include "AllocationCounter.hpp"
+#include "GameFork.hpp"
+#include "TestCheck.hpp"
+#include "TestGame.hpp"
+
+namespace {
+
+const char *const NAME = "SnapshotTest";
+
+constexpr int OPENING_TURNS = 60;
+constexpr int BRANCH_TURNS = 60;
+
+/** Play turns of the fixed policy, collecting the state after each. */
+std::vector<std::vector<long>> play(hlt::Halite &game, int turns) {
+    hlt::TurnCommands commands;
+    std::vector<std::vector<long>> states;
+    for (int turn = 0; turn < turns; turn++) {
+        play_turn(game, commands);
+        states.push_back(state(game));
+    }
+    return states;
+}
+
+/** Restoring brings back the saved state, and the game then plays out exactly as it did, down to new entity IDs. */
+void test_round_trip() {
+    TestGame game(5, 32, 2);
+    play(*game.halite, OPENING_TURNS);
+    const auto saved_state = state(*game.halite);
+    const auto snapshot = game.halite->snapshot();
+
+    const auto first_branch = play(*game.halite, BRANCH_TURNS);
+    check(NAME, first_branch.back() != saved_state, "the game moved on from the snapshot");
+    game.halite->restore(snapshot);
+    check(NAME, state(*game.halite) == saved_state, "restoring brings back the saved state");
+    const auto &bitboards = game.halite->bitboards();
+    bool every_ship_set = game.halite->store.entities.size() > 0;
+    for (const auto &entity : game.halite->store.entities) {
+        every_ship_set = every_ship_set && bitboards.ships(entity.owner).test(entity.location);
+    }
+    long cells_set = 0;
+    for (const auto &[player_id, _] : game.halite->store.players) {
+        cells_set += bitboards.ships(player_id).count();
+    }
+    check(NAME, every_ship_set && cells_set == static_cast<long>(game.halite->store.entities.size()),
+          "restoring brings back the ship bitboards");
+    check(NAME, play(*game.halite, BRANCH_TURNS) == first_branch, "the restored game plays out the same way");
+}
+
+/** A snapshot can be restored into another game set up the same way, as a search would simulate ahead. */
+void test_restore_elsewhere() {
+    TestGame game(9, 40, 4), simulation(9, 40, 4);
+    play(*game.halite, OPENING_TURNS);
+    simulation.halite->restore(game.halite->snapshot());
+    check(NAME, state(*simulation.halite) == state(*game.halite), "the other game takes on the saved state");
+    check(NAME, play(*simulation.halite, BRANCH_TURNS) == play(*game.halite, BRANCH_TURNS),
+          "the other game plays out the same way");
+}
+
+/** A fork plays out as its parent would, and playing it leaves the parent untouched. */
+void test_fork() {
+    TestGame game(13, 32, 2);
+    play(*game.halite, OPENING_TURNS);
+    const auto saved_state = state(*game.halite);
+    const auto fork = game.halite->fork();
+    check(NAME, state(fork->game) == saved_state, "the fork starts from the parent's state");
+
+    const auto fork_branch = play(fork->game, BRANCH_TURNS);
+    check(NAME, state(*game.halite) == saved_state, "playing the fork leaves the parent untouched");
+    check(NAME, play(*game.halite, BRANCH_TURNS) == fork_branch, "the parent plays out as the fork did");
+}
+
+/** Saving into and restoring from the same snapshot reuses its buffers and the store's. */
+void test_reuse_allocations() {
+    static constexpr int SEARCHES = 20;
+    TestGame game(3, 32, 2);
+    hlt::TurnCommands commands;
+    hlt::GameSnapshot snapshot;
+    play(*game.halite, OPENING_TURNS);
+
+    hlt::AllocationCount saves_and_restores;
+    for (int search = 0; search < SEARCHES; search++) {
+        const auto before_save = hlt::allocations_so_far();
+        game.halite->snapshot(snapshot);
+        const auto after_save = hlt::allocations_so_far();
+        for (int turn = 0; turn < 5; turn++) {
+            play_turn(*game.halite, commands);
+        }
+        const auto before_restore = hlt::allocations_so_far();
+        game.halite->restore(snapshot);
+        const auto after_restore = hlt::allocations_so_far();
+        if (search > 0) {
+            saves_and_restores = saves_and_restores + (after_save - before_save) + (after_restore - before_restore);
+        }
+    }
+    check(NAME, saves_and_restores.allocations == 0, "saving and restoring the same state again does not allocate");
+}
+
+}
+
+void snapshot_test() {
+    test_round_trip();
+    test_restore_elsewhere();
+    test_fork();
+    test_reuse_allocations();
+}
@@ -0,0 +1,22 @@
+#ifndef TESTCHECK_HPP
+#define TESTCHECK_HPP
+
+#include <iostream>
+
+/** The number of checks that have failed so far, in every suite. */
+inline int test_failures = 0;
+
+/**
+ * Check a condition, reporting it if it does not hold.
+ * @param name The name of the suite, to prefix the report with.
+ * @param condition The condition.
+ * @param message What the condition means, to report.
+ */
+inline void check(const char *name, bool condition, const char *message) {
+    if (!condition) {
+        std::cerr << name << ": " << message << std::endl;
+        test_failures++;
+    }
+}
+
+#endif // TESTCHECK_HPP
@@ -0,0 +1,81 @@
+#ifndef TESTGAME_HPP
+#define TESTGAME_HPP
+
+#include <memory>
+#include <vector>
+
+#include "Generator.hpp"
+#include "Halite.hpp"
+#include "Replay.hpp"
+#include "TurnCommands.hpp"
+
+/** A game on its own map, as the environments set one up. */
+struct TestGame {
+    hlt::Map map;
+    hlt::GameStatistics statistics;
+    std::unique_ptr<hlt::Replay> replay;
+    std::unique_ptr<hlt::Halite> halite;
+
+    /** Get settings with plenty of energy and free moves, which keep a fleet of ships in play. */
+    static hlt::GameConfig fleet_config() {
+        hlt::GameConfig config = hlt::Constants::get();
+        config.INITIAL_ENERGY = 100000;
+        config.MOVE_COST_RATIO = config.INSPIRED_MOVE_COST_RATIO = 100000;
+        return config;
+    }
+
+    TestGame(unsigned int seed, long size, unsigned long players, const hlt::GameConfig &config = fleet_config()) :
+            map(size, size) {
+        hlt::mapgen::MapParameters parameters{hlt::mapgen::MapType::Fractal, seed, size, size, players};
+        hlt::mapgen::Generator::generate(map, parameters);
+        replay = std::make_unique<hlt::Replay>(statistics, players, seed, map);
+        halite = std::make_unique<hlt::Halite>(map, statistics, *replay, config);
+        halite->initialize_game(static_cast<int>(players));
+        halite->turn_number = 1;
+    }
+};
+
+/**
+ * The commands of a fixed policy: each ship heads straight out of the factory in its own direction, and players
+ * spawn whenever the factory is free.
+ */
+inline void choose(hlt::Halite &game, hlt::TurnCommands &commands) {
+    commands.clear(game.store.players.size());
+    for (const auto &[player_id, player] : game.store.players) {
+        for (const auto &entity_id : player.entities) {
+            const auto action = static_cast<hlt::AgentAction>(entity_id.value % 4);
+            commands.add(player_id.value, {entity_id.value, action});
+        }
+        if (player.energy >= game.config.NEW_ENTITY_ENERGY_COST && game.map.at(player.factory).entity == hlt::Entity::None) {
+            commands.add(player_id.value, {player_id.value, hlt::AgentAction::Spawn});
+        }
+    }
+}
+
+/** Play one turn of the fixed policy, as the environments do. */
+inline void play_turn(hlt::Halite &game, hlt::TurnCommands &commands) {
+    game.update_inspiration();
+    choose(game, commands);
+    game.process_turn(commands);
+    game.turn_number++;
+}
+
+/** Everything about a game's state that commands change. */
+inline std::vector<long> state(const hlt::Halite &game) {
+    std::vector<long> values;
+    game.store.entities.for_each_in_id_order([&values](const hlt::Entity &entity) {
+        values.insert(values.end(), {entity.id.value, entity.owner.value, entity.energy,
+                                     entity.location.x, entity.location.y});
+    });
+    for (const auto &[player_id, player] : game.store.players) {
+        values.insert(values.end(), {player_id.value, player.energy, static_cast<long>(player.dropoffs.size())});
+    }
+    for (const auto &cell : game.map.grid) {
+        values.insert(values.end(), {cell.energy, cell.entity.value, cell.owner.value});
+    }
+    values.push_back(game.store.map_total_energy);
+    values.push_back(static_cast<long>(game.turn_number));
+    return values;
+}
+
+#endif // TESTGAME_HPP
@@ -1,3 +1,38 @@
+#include <iostream>
+
+#include "TestCheck.hpp"
+
+void advantage_test();
+void bitboard_test();
+void turn_commands_test();
+void snapshot_test();
+void scripted_bot_test();
+void seed_stream_test();
+void profiler_test();
+void slot_map_test();
+void threaded_games_test();
+void inspiration_field_test();
+void capture_field_test();
+void move_resolution_test();
+void mpsc_queue_test();
+
 int main (){
+    advantage_test();
+    bitboard_test();
+    turn_commands_test();
+    snapshot_test();
+    scripted_bot_test();
+    seed_stream_test();
+    profiler_test();
+    slot_map_test();
+    threaded_games_test();
+    inspiration_field_test();
+    capture_field_test();
+    move_resolution_test();
+    mpsc_queue_test();
+    if (test_failures > 0) {
+        std::cerr << test_failures << " checks failed" << std::endl;
+        return 1;
+    }
     return 0;
-}
\ No newline at end of file
+}
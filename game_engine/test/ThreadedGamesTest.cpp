@@ -0,0 +1,58 @@
+#include <thread>
+#include <vector>
+
+#include "TestCheck.hpp"
+#include "TestGame.hpp"
+
+namespace {
+
+const char *const NAME = "ThreadedGamesTest";
+
+/** A map size and the turn limit the rules give it, from 400 turns at 32x32 up to 500 at 64x64. */
+struct SizedGame {
+    long size;
+    unsigned long max_turns;
+};
+
+/**
+ * Games of different sizes, played to the end on threads of their own, each keep the turn limit of their own size
+ * and leave the global constants alone. Built with -DHALITE_TSAN=ON, this also checks that games share no state.
+ */
+void test_mixed_sizes() {
+    static const SizedGame games[] = {{32, 400}, {64, 500}, {40, 425}, {48, 450}, {32, 400}, {56, 475}};
+    static constexpr std::size_t GAMES = sizeof(games) / sizeof(games[0]);
+    const auto default_max_turns = hlt::Constants::get().MAX_TURNS;
+
+    std::vector<unsigned long> max_turns(GAMES), turns_played(GAMES);
+    std::vector<std::thread> threads;
+    for (std::size_t index = 0; index < GAMES; index++) {
+        threads.emplace_back([index, &max_turns, &turns_played]() {
+            TestGame game(static_cast<unsigned int>(index + 1), games[index].size, 2);
+            auto &halite = *game.halite;
+            hlt::TurnCommands commands;
+            while (!halite.game_ended() && halite.turn_number < halite.config.MAX_TURNS) {
+                play_turn(halite, commands);
+            }
+            max_turns[index] = halite.config.MAX_TURNS;
+            turns_played[index] = halite.turn_number;
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    bool limits = true, bounded = true;
+    for (std::size_t index = 0; index < GAMES; index++) {
+        limits = limits && max_turns[index] == games[index].max_turns;
+        bounded = bounded && turns_played[index] > 1 && turns_played[index] <= games[index].max_turns;
+    }
+    check(NAME, limits, "a game took another size's turn limit");
+    check(NAME, bounded, "a game played past its own turn limit");
+    check(NAME, hlt::Constants::get().MAX_TURNS == default_max_turns, "a game changed the global constants");
+}
+
+}
+
+void threaded_games_test() {
+    test_mixed_sizes();
+}
@@ -0,0 +1,89 @@
+#include <map>
+#include <string>
+#include <vector>
+
+#define HALITE_COUNT_ALLOCATIONS
+#include "AllocationCounter.hpp"
+
+#include "TestCheck.hpp"
+#include "TestGame.hpp"
+
+namespace {
+
+const char *const NAME = "TurnCommandsTest";
+
+/** The same commands in the string form. */
+std::map<long, std::vector<AgentCommand>> as_strings(const hlt::TurnCommands &commands) {
+    static const std::string names[] = {"N", "E", "S", "W", "still", "spawn", "construct"};
+    std::map<long, std::vector<AgentCommand>> raw;
+    for (std::size_t player = 0; player < commands.players(); player++) {
+        auto &player_raw = raw[static_cast<long>(player)];
+        for (const auto &command : commands.of(player)) {
+            player_raw.emplace_back(command.entity, names[static_cast<int>(command.action)]);
+        }
+    }
+    return raw;
+}
+
+/** The string commands are a thin adapter: both forms play out the same game. */
+void test_string_adapter() {
+    TestGame typed(11, 32, 2), strings(11, 32, 2);
+    hlt::TurnCommands commands;
+    bool same = true;
+    for (int turn = 0; turn < 200; turn++) {
+        typed.halite->update_inspiration();
+        strings.halite->update_inspiration();
+        choose(*typed.halite, commands);
+        typed.halite->process_turn(commands);
+        strings.halite->process_turn(as_strings(commands));
+        typed.halite->turn_number++;
+        strings.halite->turn_number++;
+        same = same && state(*typed.halite) == state(*strings.halite);
+    }
+    check(NAME, same, "typed and string commands give the same game");
+    check(NAME, !typed.halite->store.entities.empty(), "ships were spawned");
+}
+
+/**
+ * A typed turn neither copies players nor builds per-command objects on the heap. What is left is the bookkeeping
+ * of the command transaction, a few small allocations per command, and entities that are created.
+ */
+void test_turn_allocations() {
+    static constexpr int WARM_UP_TURNS = 50;
+    static constexpr int MEASURED_TURNS = 150;
+    static constexpr unsigned long ALLOCATIONS_PER_COMMAND = 4;
+    static constexpr unsigned long ALLOCATIONS_PER_TURN = 32;
+
+    TestGame game(7, 32, 2);
+    hlt::TurnCommands commands;
+    hlt::AllocationCount refills, turns;
+    unsigned long issued = 0;
+    for (int turn = 0; turn < WARM_UP_TURNS + MEASURED_TURNS; turn++) {
+        game.halite->update_inspiration();
+        const auto before_choice = hlt::allocations_so_far();
+        choose(*game.halite, commands);
+        const auto before_turn = hlt::allocations_so_far();
+        game.halite->process_turn(commands);
+        const auto after_turn = hlt::allocations_so_far();
+        game.halite->turn_number++;
+
+        if (turn >= WARM_UP_TURNS) {
+            refills = refills + (before_turn - before_choice);
+            turns = turns + (after_turn - before_turn);
+            for (std::size_t player = 0; player < commands.players(); player++) {
+                issued += commands.of(player).size();
+            }
+        }
+    }
+    check(NAME, issued > 0, "commands were issued");
+    check(NAME, refills.allocations < MEASURED_TURNS / 10, "refilling turn commands reuses their buffers");
+    check(NAME, turns.allocations <= ALLOCATIONS_PER_COMMAND * issued + ALLOCATIONS_PER_TURN * MEASURED_TURNS,
+          "turn allocations stay within the transaction's per-command bookkeeping");
+}
+
+}
+
+void turn_commands_test() {
+    test_string_adapter();
+    test_turn_allocations();
+}
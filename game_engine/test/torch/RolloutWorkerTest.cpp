@@ -0,0 +1,86 @@
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "SeedStream.hpp"
+#include "../TestCheck.hpp"
+#include "../../mpsc_queue.hpp"
+#include "../../rollout_worker.hpp"
+
+#include <torch/torch.h>
+
+/**
+ * Tests of the rollout workers, built only with libtorch: a game plays out the same from its map seed and policy
+ * version, however many workers and games per worker share the run and whenever the learner publishes.
+ */
+
+namespace {
+
+const char *const NAME = "RolloutWorkerTest";
+
+constexpr uint64_t MASTER_SEED = 7;
+
+/**
+ * Start workers as the Agent does, publish new weights while their first games are under way, and wait for the first
+ * game of the first worker's first slot.
+ * @param workers The number of workers.
+ * @param games_per_worker The number of games each worker plays at once.
+ * @param initial The weights published before the workers start.
+ * @param update The weights published once they have started.
+ * @return The game.
+ */
+Trajectory first_game(std::size_t workers, std::size_t games_per_worker, const ActorCriticNetwork &initial,
+                      const ActorCriticNetwork &update) {
+    const hlt::SeedStream seeds(MASTER_SEED);
+    const auto seed = seeds.substream(1).substream(0).seed(0);
+
+    PolicyStore policies;
+    policies.publish(initial);
+    BoundedMpscQueue<Trajectory> trajectories(64);
+    std::vector<std::unique_ptr<RolloutWorker>> running;
+    for (std::size_t i = 0; i < workers; i++) {
+        running.push_back(std::make_unique<RolloutWorker>(policies, trajectories, games_per_worker,
+                                                          seeds.substream(1 + i)));
+    }
+    policies.publish(update);
+
+    Trajectory trajectory;
+    while (!trajectories.try_pop(trajectory) || trajectory.seed != seed) {
+        std::this_thread::yield();
+    }
+    return trajectory;
+}
+
+/** Check that a game kept the version it started with on every turn. */
+void check_one_version(const Trajectory &trajectory) {
+    check(NAME, trajectory.policyVersion == 0, "a game was not played by the version published when it started");
+    bool same = true;
+    for (const auto version : trajectory.rollouts.policyVersion) {
+        same = same && version == trajectory.policyVersion;
+    }
+    check(NAME, same, "a game changed policy version between turns");
+}
+
+}
+
+int main(int, char *[]) {
+    torch::manual_seed(1);
+    const ActorCriticNetwork initial(false);
+    const ActorCriticNetwork update(false);
+
+    const auto alone = first_game(1, 1, initial, update);
+    const auto shared = first_game(3, 2, initial, update);
+    check_one_version(alone);
+    check_one_version(shared);
+    check(NAME, alone.gameSteps == shared.gameSteps && alone.scores == shared.scores,
+          "a game's outcome depends on the number of workers");
+    check(NAME, alone.rollouts.action == shared.rollouts.action && alone.rollouts.entity == shared.rollouts.entity,
+          "a game's actions depend on the number of workers");
+
+    if (test_failures > 0) {
+        std::cerr << test_failures << " checks failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
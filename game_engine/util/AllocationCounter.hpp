@@ -0,0 +1,88 @@
+#ifndef ALLOCATIONCOUNTER_HPP
+#define ALLOCATIONCOUNTER_HPP
+
+#include <cstddef>
+
+namespace hlt {
+
+/** Heap allocations made by one thread, and the bytes they asked for. */
+struct AllocationCount {
+    unsigned long allocations{}; /**< The number of calls to operator new. */
+    unsigned long bytes{};       /**< The total size requested; copies of containers show up here. */
+
+    /**
+     * Add another count, to accumulate counts over several intervals.
+     * @param other The other count.
+     * @return The sum.
+     */
+    AllocationCount operator+(const AllocationCount &other) const {
+        return {allocations + other.allocations, bytes + other.bytes};
+    }
+
+    /**
+     * Get the allocations made since an earlier count.
+     * @param earlier The earlier count.
+     * @return The difference.
+     */
+    AllocationCount operator-(const AllocationCount &earlier) const {
+        return {allocations - earlier.allocations, bytes - earlier.bytes};
+    }
+};
+
+/**
+ * Get the allocations made by the calling thread so far.
+ *
+ * Counting replaces the global operator new, so it is compiled into a program only by defining
+ * HALITE_COUNT_ALLOCATIONS in exactly one of its source files before including this header. Programs that do not
+ * define it must not call this function.
+ *
+ * @return The running count.
+ */
+AllocationCount allocations_so_far();
+
+}
+
+#ifdef HALITE_COUNT_ALLOCATIONS
+
+#include <cstdlib>
+#include <new>
+
+namespace hlt {
+
+namespace {
+
+/** The running count of the calling thread. */
+thread_local AllocationCount thread_allocations;
+
+/**
+ * Count and make an allocation.
+ * @param size The requested size.
+ * @return The allocated memory.
+ */
+void *counted_allocation(std::size_t size) {
+    thread_allocations.allocations++;
+    thread_allocations.bytes += size;
+    if (void *memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+}
+
+AllocationCount allocations_so_far() {
+    return thread_allocations;
+}
+
+}
+
+void *operator new(std::size_t size) { return hlt::counted_allocation(size); }
+void *operator new[](std::size_t size) { return hlt::counted_allocation(size); }
+void operator delete(void *memory) noexcept { std::free(memory); }
+void operator delete[](void *memory) noexcept { std::free(memory); }
+void operator delete(void *memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void *memory, std::size_t) noexcept { std::free(memory); }
+
+#endif // HALITE_COUNT_ALLOCATIONS
+
+#endif // ALLOCATIONCOUNTER_HPP
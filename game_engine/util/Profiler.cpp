@@ -0,0 +1,214 @@
+#include <algorithm>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Profiler.hpp"
+
+namespace hlt {
+
+namespace {
+
+/** The histograms of every phase on maps of one size. */
+struct SizeProfile {
+    long width;
+    long height;
+    std::array<TickHistogram, static_cast<std::size_t>(Phase::Count)> phases{};
+};
+
+/** The histograms recorded by one thread, by map size. */
+struct ThreadProfile {
+    std::vector<SizeProfile> sizes;
+
+    /**
+     * Get the histograms of a map size, adding them on first use.
+     * @param width The width of the map.
+     * @param height The height of the map.
+     * @return The histograms.
+     */
+    SizeProfile &of(long width, long height) {
+        for (auto &size : sizes) {
+            if (size.width == width && size.height == height) {
+                return size;
+            }
+        }
+        sizes.push_back({width, height});
+        return sizes.back();
+    }
+};
+
+/** Guards the list of thread profiles. */
+std::mutex profiles_mutex;
+
+/**
+ * Get the profiles of every thread that has recorded. They outlive their threads, so a summary at the end of a run
+ * still sees the threads that have finished.
+ * @return The profiles.
+ */
+std::vector<std::unique_ptr<ThreadProfile>> &profiles() {
+    static std::vector<std::unique_ptr<ThreadProfile>> all;
+    return all;
+}
+
+/**
+ * Get the profile of the calling thread, registering it on first use.
+ * @return The profile.
+ */
+ThreadProfile &thread_profile() {
+    thread_local ThreadProfile *profile = nullptr;
+    if (profile == nullptr) {
+        std::lock_guard<std::mutex> guard(profiles_mutex);
+        profiles().push_back(std::make_unique<ThreadProfile>());
+        profile = profiles().back().get();
+    }
+    return *profile;
+}
+
+}
+
+/**
+ * Get the name of a phase, as the profile summary prints it.
+ * @param phase The phase.
+ * @return The name.
+ */
+const char *phase_name(Phase phase) {
+    switch (phase) {
+    case Phase::Convert:
+        return "convert";
+    case Phase::Turn:
+        return "turn";
+    case Phase::Parse:
+        return "parse";
+    case Phase::Check:
+        return "check";
+    case Phase::Commit:
+        return "commit";
+    case Phase::Mining:
+        return "mining";
+    case Phase::Capture:
+        return "capture";
+    case Phase::PlayerStats:
+        return "player_stats";
+    case Phase::Inspiration:
+        return "inspiration";
+    case Phase::Count:
+        break;
+    }
+    return "unknown";
+}
+
+/**
+ * Get the bucket of a duration.
+ * @param ticks The duration.
+ * @return The index of its bucket.
+ */
+std::size_t TickHistogram::bucket(uint64_t ticks) {
+    if (ticks < SUB_BUCKETS) {
+        return static_cast<std::size_t>(ticks);
+    }
+    // The top bit picks the power of two, and the next SUB_BUCKET_BITS bits the slice of it.
+    const auto top_bit = 63U - static_cast<unsigned>(__builtin_clzll(ticks));
+    const auto slice = (ticks >> (top_bit - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+    return ((top_bit - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS) | static_cast<std::size_t>(slice);
+}
+
+/**
+ * Get the smallest duration in a bucket.
+ * @param index The index of the bucket.
+ * @return The duration.
+ */
+uint64_t TickHistogram::lower_bound(std::size_t index) {
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+    const auto top_bit = static_cast<unsigned>(index >> SUB_BUCKET_BITS) + SUB_BUCKET_BITS - 1;
+    const auto slice = static_cast<uint64_t>(index & (SUB_BUCKETS - 1));
+    return (uint64_t{1} << top_bit) | (slice << (top_bit - SUB_BUCKET_BITS));
+}
+
+/**
+ * Add the durations of another histogram.
+ * @param other The other histogram.
+ */
+void TickHistogram::merge(const TickHistogram &other) {
+    for (std::size_t index = 0; index < counts.size(); index++) {
+        counts[index] += other.counts[index];
+    }
+    total += other.total;
+}
+
+/**
+ * Get a percentile of the durations, by the nearest rank.
+ * @param percent The percentile, from 0 to 100.
+ * @return The lower bound of the bucket holding it, or 0 if the histogram is empty.
+ */
+uint64_t TickHistogram::percentile(double percent) const {
+    if (total == 0) {
+        return 0;
+    }
+    const auto rank = static_cast<uint64_t>(static_cast<double>(total - 1) * percent / 100.0);
+    uint64_t seen = 0;
+    for (std::size_t index = 0; index < counts.size(); index++) {
+        seen += counts[index];
+        if (seen > rank) {
+            return lower_bound(index);
+        }
+    }
+    return lower_bound(counts.size() - 1);
+}
+
+/**
+ * Record a duration of a phase in the histograms of the calling thread.
+ * @param phase The phase.
+ * @param width The width of the game's map.
+ * @param height The height of the game's map.
+ * @param ticks The duration.
+ */
+void record_phase(Phase phase, long width, long height, uint64_t ticks) {
+    thread_profile().of(width, height).phases[static_cast<std::size_t>(phase)].add(ticks);
+}
+
+/**
+ * Write the p50 and p99 of each phase and map size, merged over all threads that recorded any.
+ * @param out The stream to write to.
+ */
+void write_profile(std::ostream &out) {
+    ThreadProfile merged;
+    {
+        std::lock_guard<std::mutex> guard(profiles_mutex);
+        for (const auto &profile : profiles()) {
+            for (const auto &size : profile->sizes) {
+                auto &into = merged.of(size.width, size.height);
+                for (std::size_t phase = 0; phase < size.phases.size(); phase++) {
+                    into.phases[phase].merge(size.phases[phase]);
+                }
+            }
+        }
+    }
+    if (merged.sizes.empty()) {
+        return;
+    }
+    std::sort(merged.sizes.begin(), merged.sizes.end(), [](const SizeProfile &first, const SizeProfile &second) {
+        return first.width * first.height < second.width * second.height;
+    });
+
+    out << "Ticks per call of each phase of a turn" << std::endl
+        << std::left << std::setw(10) << "map" << std::setw(14) << "phase"
+        << std::right << std::setw(12) << "calls" << std::setw(12) << "p50" << std::setw(12) << "p99" << std::endl;
+    for (const auto &size : merged.sizes) {
+        const auto name = std::to_string(size.width) + "x" + std::to_string(size.height);
+        for (std::size_t phase = 0; phase < size.phases.size(); phase++) {
+            const auto &histogram = size.phases[phase];
+            if (histogram.count() == 0) {
+                continue;
+            }
+            out << std::left << std::setw(10) << name << std::setw(14) << phase_name(static_cast<Phase>(phase))
+                << std::right << std::setw(12) << histogram.count() << std::setw(12) << histogram.percentile(50)
+                << std::setw(12) << histogram.percentile(99) << std::endl;
+        }
+    }
+}
+
+}
@@ -0,0 +1,166 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace hlt {
+
+/** The phases of a turn that are timed. */
+enum class Phase {
+    Convert,        /**< Converting string commands into TurnCommands, before Turn starts. */
+    Turn,           /**< All of Halite::process_turn. */
+    Parse,          /**< Turning the commands of each player into engine commands. */
+    Check,          /**< Adding the commands to a CommandTransaction and checking them. */
+    Commit,         /**< Committing a checked CommandTransaction. */
+    Mining,         /**< Extracting energy for the ships that stayed still. */
+    Capture,        /**< Flipping captured ships. */
+    PlayerStats,    /**< update_player_stats. */
+    Inspiration,    /**< update_inspiration. */
+    Count           /**< The number of phases. */
+};
+
+/**
+ * Get the name of a phase, as the profile summary prints it.
+ * @param phase The phase.
+ * @return The name.
+ */
+const char *phase_name(Phase phase);
+
+/**
+ * Read the timer the profiler uses.
+ * @return The time stamp counter on x86, otherwise the steady clock in nanoseconds.
+ */
+inline uint64_t profile_ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/**
+ * A histogram of durations, in ticks, with buckets of 1/8 of a power of two.
+ *
+ * Each bucket spans at most 1/8 of its lower bound, so a percentile is reported to within 12.5% over the whole
+ * range of a 64-bit count, in a fixed array that needs no allocation to record into.
+ */
+class TickHistogram {
+    static constexpr unsigned SUB_BUCKET_BITS = 3;
+    static constexpr unsigned SUB_BUCKETS = 1U << SUB_BUCKET_BITS;
+
+    std::array<uint64_t, 64 * SUB_BUCKETS> counts{}; /**< The number of durations in each bucket. */
+    uint64_t total{};                                /**< The number of durations recorded. */
+
+    /**
+     * Get the bucket of a duration.
+     * @param ticks The duration.
+     * @return The index of its bucket.
+     */
+    static std::size_t bucket(uint64_t ticks);
+
+    /**
+     * Get the smallest duration in a bucket.
+     * @param index The index of the bucket.
+     * @return The duration.
+     */
+    static uint64_t lower_bound(std::size_t index);
+
+public:
+    /**
+     * Record a duration.
+     * @param ticks The duration.
+     */
+    void add(uint64_t ticks) {
+        counts[bucket(ticks)]++;
+        total++;
+    }
+
+    /**
+     * Add the durations of another histogram.
+     * @param other The other histogram.
+     */
+    void merge(const TickHistogram &other);
+
+    /**
+     * Get the number of durations recorded.
+     * @return The number.
+     */
+    uint64_t count() const { return total; }
+
+    /**
+     * Get a percentile of the durations, by the nearest rank.
+     * @param percent The percentile, from 0 to 100.
+     * @return The lower bound of the bucket holding it, or 0 if the histogram is empty.
+     */
+    uint64_t percentile(double percent) const;
+};
+
+/**
+ * Record a duration of a phase in the histograms of the calling thread.
+ * @param phase The phase.
+ * @param width The width of the game's map.
+ * @param height The height of the game's map.
+ * @param ticks The duration.
+ */
+void record_phase(Phase phase, long width, long height, uint64_t ticks);
+
+/**
+ * Write the p50 and p99 of each phase and map size, merged over all threads that recorded any.
+ *
+ * The histograms of a thread are read without locking, so this is meant for the end of a run, after the threads
+ * that play games have finished. Nothing is written if nothing was recorded.
+ *
+ * @param out The stream to write to.
+ */
+void write_profile(std::ostream &out);
+
+/** Times the enclosing scope as one call of a phase. */
+class ScopedTimer {
+    Phase phase;
+    long width;
+    long height;
+    uint64_t start;
+
+public:
+    /**
+     * Start timing.
+     * @param phase The phase.
+     * @param width The width of the game's map.
+     * @param height The height of the game's map.
+     */
+    ScopedTimer(Phase phase, long width, long height) :
+            phase(phase), width(width), height(height), start(profile_ticks()) {}
+
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+    /** Stop timing and record the duration. */
+    ~ScopedTimer() {
+        record_phase(phase, width, height, profile_ticks() - start);
+    }
+};
+
+}
+
+/**
+ * Time the rest of the enclosing scope as one call of a phase of hlt::Phase, on a map of the given size.
+ * Timers are compiled in only when HALITE_PROFILE is defined, which the HALITE_PROFILE CMake option does.
+ */
+#ifdef HALITE_PROFILE
+#define HALITE_PROFILE_CONCAT_(prefix, line) prefix##line
+#define HALITE_PROFILE_NAME_(line) HALITE_PROFILE_CONCAT_(halite_profile_timer_, line)
+#define HALITE_PROFILE_SCOPE(phase, width, height) \
+    ::hlt::ScopedTimer HALITE_PROFILE_NAME_(__LINE__)(::hlt::Phase::phase, (width), (height))
+#else
+#define HALITE_PROFILE_SCOPE(phase, width, height) static_cast<void>(0)
+#endif
+
+#endif // PROFILER_HPP
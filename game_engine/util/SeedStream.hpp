@@ -0,0 +1,81 @@
+#ifndef SEEDSTREAM_HPP
+#define SEEDSTREAM_HPP
+
+#include <cstdint>
+
+namespace hlt {
+
+/**
+ * Advance a SplitMix64 state by one step and return its output.
+ * @param state The state; consecutive states differ by the golden ratio increment.
+ * @return The mixed output.
+ */
+constexpr uint64_t split_mix(uint64_t state) {
+    state += 0x9e3779b97f4a7c15ULL;
+    state = (state ^ (state >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+    state = (state ^ (state >> 27U)) * 0x94d049bb133111ebULL;
+    return state ^ (state >> 31U);
+}
+
+/**
+ * A counter-based stream of seeds, derived from one master seed.
+ *
+ * The seed at an index is a pure function of the stream's key and the index, so any seed can be computed directly,
+ * in any order and on any thread, without shared generator state. A substream is a stream of its own, keyed by a
+ * seed of its parent, so a master seed splits into a tree of streams: per worker, per game slot, per episode.
+ * Whatever is drawn from a stream depends only on its place in the tree, never on how the work was scheduled.
+ */
+class SeedStream {
+    uint64_t key{};   /**< The key; the stream's seeds are the SplitMix64 sequence starting from it. */
+
+public:
+    /** Construct the stream of master seed zero. */
+    constexpr SeedStream() : SeedStream(0) {}
+
+    /**
+     * Construct a SeedStream.
+     * @param master The master seed.
+     */
+    explicit constexpr SeedStream(uint64_t master) : key(split_mix(master)) {}
+
+    /**
+     * Get a 64-bit value of the stream.
+     * @param index The position in the stream.
+     * @return The value.
+     */
+    constexpr uint64_t at(uint64_t index) const {
+        return split_mix(key + index * 0x9e3779b97f4a7c15ULL);
+    }
+
+    /**
+     * Get a seed for a 32-bit generator or the map generator.
+     * @param index The position in the stream.
+     * @return The seed.
+     */
+    constexpr unsigned int seed(uint64_t index) const {
+        return static_cast<unsigned int>(at(index) >> 32U);
+    }
+
+    /**
+     * Get a number drawn uniformly from [0, 1).
+     * @param index The position in the stream.
+     * @return The number, with 24 random bits.
+     */
+    constexpr float uniform(uint64_t index) const {
+        return static_cast<float>(at(index) >> 40U) * (1.0f / 16777216.0f);
+    }
+
+    /**
+     * Get an independent stream derived from this one.
+     * @param index The position of the substream.
+     * @return The substream.
+     */
+    constexpr SeedStream substream(uint64_t index) const {
+        // Mixing with a constant keeps substream keys apart from the seeds handed out at the same index.
+        return SeedStream(at(index) ^ 0x5eed5eed5eed5eedULL);
+    }
+};
+
+}
+
+#endif // SEEDSTREAM_HPP
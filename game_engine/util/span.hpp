@@ -0,0 +1,53 @@
+#ifndef SPAN_HPP
+#define SPAN_HPP
+
+#include <cstddef>
+
+namespace hlt {
+
+/**
+ * Non-owning view over a contiguous run of objects, in lieu of std::span.
+ * @tparam T The type of the viewed objects, const-qualified for read-only views.
+ */
+template<class T>
+class Span {
+    T *first{};          /**< The first viewed object. */
+    std::size_t count{}; /**< The number of viewed objects. */
+
+public:
+    /** Default constructor, creating an empty view. */
+    constexpr Span() = default;
+
+    /**
+     * Create a Span from a pointer and a length.
+     * @param first The first viewed object.
+     * @param count The number of viewed objects.
+     */
+    constexpr Span(T *first, std::size_t count) : first(first), count(count) {}
+
+    /** Get a pointer to the first viewed object. */
+    constexpr T *data() const { return first; }
+
+    /** Get the number of viewed objects. */
+    constexpr std::size_t size() const { return count; }
+
+    /** Get whether the view is empty. */
+    constexpr bool empty() const { return count == 0; }
+
+    /** Get an iterator to the first viewed object. */
+    constexpr T *begin() const { return first; }
+
+    /** Get an iterator past the last viewed object. */
+    constexpr T *end() const { return first + count; }
+
+    /**
+     * Get a reference to a viewed object.
+     * @param index The index of the object.
+     * @return Reference to the object.
+     */
+    constexpr T &operator[](std::size_t index) const { return first[index]; }
+};
+
+}
+
+#endif // SPAN_HPP
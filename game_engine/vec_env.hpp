@@ -0,0 +1,205 @@
+#ifndef VEC_ENV_HPP
+#define VEC_ENV_HPP
+
+#include <cassert>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include "Constants.hpp"
+#include "Generator.hpp"
+#include "Halite.hpp"
+#include "Replay.hpp"
+#include "Enumerated.hpp"
+#include "SeedStream.hpp"
+
+/** A ship awaiting an action on the current turn. */
+struct ShipSlot {
+    std::size_t game;             /**< The index of the game the ship is in. */
+    long player_id;               /**< The owner of the ship. */
+    hlt::Entity::id_type entity;  /**< The ID of the ship. */
+    hlt::Location location;       /**< The location of the ship. */
+    hlt::energy_type energy;      /**< The energy carried by the ship. */
+};
+
+/** The outcome of a game that ended on the last step. */
+struct FinishedGame {
+    std::size_t game;             /**< The index of the game, which has since been reset. */
+    unsigned int seed;            /**< The map seed the game was played with. */
+    unsigned long turns;          /**< The number of turns the game lasted. */
+    std::vector<long> scores;     /**< The final production of each player, by player ID. */
+};
+
+/**
+ * N independent Halite games stepped in lockstep.
+ *
+ * Every turn, the ships of all games are listed in one flat array so that a policy can be evaluated for all of
+ * them in a single batch. The actions for that array are then scattered back to each game's process_turn.
+ * Games that end are recorded and immediately restarted on a fresh map seed, so there is always a full set of
+ * games to step.
+ */
+class VecHaliteEnv {
+    /** The state owned by a single game, which Halite refers to rather than owns. */
+    struct Game {
+        std::unique_ptr<hlt::Map> map;
+        std::unique_ptr<hlt::GameStatistics> game_statistics;
+        std::unique_ptr<hlt::Replay> replay;
+        std::unique_ptr<hlt::Halite> halite;
+        hlt::SeedStream seeds;      /**< The map seeds of the games played in this slot. */
+        unsigned long episodes{};   /**< The number of games started in this slot. */
+        unsigned int seed{};        /**< The map seed of the current game. */
+    };
+
+    long map_width;
+    long map_height;
+    std::size_t num_players;
+    hlt::GameConfig config;
+
+    std::vector<Game> games;
+    std::vector<ShipSlot> current_ships;
+    std::vector<float> last_rewards;
+    std::vector<FinishedGame> last_finished;
+    std::vector<hlt::TurnCommands> commands;
+
+    /**
+     * Start a new game in a slot, on the slot's next map seed.
+     * @param game The game to reset.
+     */
+    void reset(Game &game) {
+        // Halite refers to the other members, so it must go first.
+        game.halite.reset();
+        game.seed = game.seeds.seed(game.episodes++);
+
+        hlt::mapgen::MapParameters map_parameters{hlt::mapgen::MapType::Fractal, game.seed,
+                                                  map_width, map_height, num_players};
+        game.map = std::make_unique<hlt::Map>(map_width, map_height);
+        hlt::mapgen::Generator::generate(*game.map, map_parameters, config);
+        game.game_statistics = std::make_unique<hlt::GameStatistics>();
+        game.replay = std::make_unique<hlt::Replay>(*game.game_statistics, num_players, game.seed, *game.map);
+        game.halite = std::make_unique<hlt::Halite>(*game.map, *game.game_statistics, *game.replay, config);
+
+        game.halite->initialize_game(num_players);
+        game.halite->turn_number = 1;
+    }
+
+    /** List the ships of every game for the coming turn, updating inspiration first. */
+    void collect_ships() {
+        current_ships.clear();
+        for (std::size_t index = 0; index < games.size(); index++) {
+            auto &game = *games[index].halite;
+            // Inspiration flags are used for mining and are visible to the policy.
+            game.update_inspiration();
+            for (const auto &[player_id, player] : game.store.players) {
+                for (const auto &entity_id : player.entities) {
+                    const auto &entity = game.store.get_entity(entity_id);
+                    current_ships.push_back({index, player_id.value, entity_id, entity.location, entity.energy});
+                }
+            }
+        }
+    }
+
+public:
+    /**
+     * Create and start a set of games.
+     * @param num_games The number of games to step together.
+     * @param map_width The width of each map.
+     * @param map_height The height of each map.
+     * @param num_players The number of players in each game.
+     * @param seeds The stream of map seeds. Each game slot draws its games from its own substream, so the games of
+     *              a slot do not depend on how many other slots there are.
+     * @param config The settings of every game, by default the global constants.
+     */
+    VecHaliteEnv(std::size_t num_games, long map_width, long map_height, std::size_t num_players,
+                 const hlt::SeedStream &seeds, const hlt::GameConfig &config = hlt::Constants::get()) :
+            map_width(map_width), map_height(map_height), num_players(num_players),
+            config(config), games(num_games), commands(num_games) {
+        for (std::size_t index = 0; index < games.size(); index++) {
+            games[index].seeds = seeds.substream(index);
+            reset(games[index]);
+        }
+        collect_ships();
+    }
+
+    /** Get the number of games. */
+    std::size_t size() const { return games.size(); }
+
+    /**
+     * Get a game.
+     * @param index The index of the game.
+     * @return The game, valid until it ends and is reset.
+     */
+    hlt::Halite &game(std::size_t index) { return *games[index].halite; }
+
+    /**
+     * Get the map seed of a game, which identifies it for replaying.
+     * @param index The index of the game.
+     * @return The seed of the game currently in that slot.
+     */
+    unsigned int seed(std::size_t index) const { return games[index].seed; }
+
+    /** Get the ships to act on the next step, grouped by game and in ID order within each game. */
+    const std::vector<ShipSlot> &ships() const { return current_ships; }
+
+    /** Get the energy each ship of the last step dropped off, aligned with ships() before that step. */
+    const std::vector<float> &rewards() const { return last_rewards; }
+
+    /** Get the games that ended on the last step. */
+    const std::vector<FinishedGame> &finished() const { return last_finished; }
+
+    /**
+     * Play one turn in every game.
+     * @param actions The action index of each ship, aligned with ships().
+     */
+    void step(const std::vector<long> &actions) {
+        assert(actions.size() == current_ships.size());
+
+        for (auto &game_commands : commands) {
+            game_commands.clear(num_players);
+        }
+        for (std::size_t i = 0; i < current_ships.size(); i++) {
+            const auto &ship = current_ships[i];
+            // Actions are the move directions, in AgentAction order.
+            assert(actions[i] >= 0 && actions[i] <= static_cast<long>(hlt::AgentAction::Still));
+            commands[ship.game].add(ship.player_id, {ship.entity.value, static_cast<hlt::AgentAction>(actions[i])});
+        }
+
+        last_finished.clear();
+        last_rewards.resize(current_ships.size());
+        std::size_t first_ship = 0;
+        for (std::size_t index = 0; index < games.size(); index++) {
+            auto &game = *games[index].halite;
+            auto &game_commands = commands[index];
+            const auto &constants = game.config;
+
+            // Players without ships spawn one whenever they can.
+            for (const auto &[player_id, player] : game.store.players) {
+                if (player.entities.empty() && player.energy >= constants.NEW_ENTITY_ENERGY_COST
+                    && game.map.at(player.factory).entity == hlt::Entity::None) {
+                    game_commands.add(player_id.value, {player_id.value, hlt::AgentAction::Spawn});
+                }
+            }
+
+            // On every turn we reset the lookup for collected halite.
+            game.store.energy_dropped_off.clear();
+            game.process_turn(game_commands);
+
+            for (; first_ship < current_ships.size() && current_ships[first_ship].game == index; first_ship++) {
+                last_rewards[first_ship] = game.store.get_energy_dropped_off(current_ships[first_ship].entity);
+            }
+
+            game.turn_number = game.turn_number + 1;
+            if (game.game_ended() || game.turn_number >= constants.MAX_TURNS) {
+                FinishedGame finished{index, games[index].seed, game.turn_number, {}};
+                for (const auto &statistics : game.game_statistics.player_statistics) {
+                    finished.scores.push_back(statistics.turn_productions.back());
+                }
+                last_finished.push_back(std::move(finished));
+                reset(games[index]);
+            }
+        }
+
+        collect_ships();
+    }
+};
+
+#endif // VEC_ENV_HPP
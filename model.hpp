@@ -8,6 +8,7 @@
 struct ActorCriticNetwork : torch::nn::Module {
 public:
 
+    /*Build the network on the CPU; place() moves it to the device it should run on*/
     ActorCriticNetwork(bool training)
     :   conv1(torch::nn::Conv2dOptions(NUMBER_OF_FRAMES, 32, /*kernel_size=*/7)),
         conv2(torch::nn::Conv2dOptions(32, 64, /*kernel_size=*/3)),
@@ -15,7 +16,7 @@ public:
         fc1(64 * (GAME_HEIGHT - 10) * (GAME_WIDTH - 10), 256),
         fc2(256, 5),               //Actor head - Ship
         fc3(256, 1),               //Critic head
-        device(torch::Device(torch::kCUDA))
+        device(torch::Device(torch::kCPU))
     {
         register_module("conv1", conv1);
         register_module("conv2", conv2);
@@ -24,16 +25,6 @@ public:
         register_module("fc2", fc2);
         register_module("fc3", fc3);
 
-        torch::DeviceType device_type;
-        if (torch::cuda::is_available()) {
-            device_type = torch::kCUDA;
-        } else {
-            device_type = torch::kCPU;
-        }
-
-        device = torch::Device(device_type);
-        this->to(device);
-
         if(training) {
             //Print out network information at beginning of run
             std::cout << "Conv1: (";
@@ -68,9 +59,49 @@ public:
         }
     }
 
+    /*Move the weights to a device, where forward then runs*/
+    void place(torch::Device device) {
+        this->device = device;
+        this->to(device);
+    }
+
     ModelOutput forward(torch::Tensor x, torch::Tensor selected_action) {
         x = x.to(this->device);
         x = torch::relu(conv1->forward(x));
+        return heads(x, selected_action);
+    }
+
+    /*
+     * Evaluate ships whose inputs are split into frames shared by every ship of a player and frames of each ship.
+     * conv1 is linear in its input channels, so it is applied to the shared frames once per (turn, player)
+     * and to the ship frames once per ship, and the two are summed after broadcasting the shared part to each ship.
+     * shared: [S, NUMBER_OF_SHARED_FRAMES, H, W], shared_index: [B] rows of shared, ship: [B, NUMBER_OF_SHIP_FRAMES, H, W]
+     * draws: optional [B, 1] uniform numbers in [0, 1) that sample the actions instead of torch's global generator
+     */
+    ModelOutput forward(torch::Tensor shared, torch::Tensor shared_index, torch::Tensor ship, torch::Tensor selected_action, torch::Tensor draws = torch::Tensor()) {
+        shared = shared.to(this->device);
+        shared_index = shared_index.to(this->device);
+        ship = ship.to(this->device);
+
+        auto weight = conv1->weight;
+        auto shared_features = torch::conv2d(shared, weight.narrow(1, 0, NUMBER_OF_SHARED_FRAMES), conv1->bias);
+        auto ship_features = torch::conv2d(ship, weight.narrow(1, NUMBER_OF_SHARED_FRAMES, NUMBER_OF_SHIP_FRAMES));
+        auto x = torch::relu(shared_features.index_select(0, shared_index) + ship_features);
+        return heads(x, selected_action, draws);
+    }
+
+    torch::nn::Conv2d conv1;
+    torch::nn::Conv2d conv2;
+    torch::nn::Conv2d conv3;
+    torch::nn::Linear fc1;
+    torch::nn::Linear fc2;
+    torch::nn::Linear fc3;
+    
+    torch::Device device;
+
+private:
+    /*Run the layers after conv1 and sample or evaluate actions*/
+    ModelOutput heads(torch::Tensor x, torch::Tensor selected_action, torch::Tensor draws = torch::Tensor()) {
         x = torch::relu(conv2->forward(x));
         x = torch::relu(conv3->forward(x));
         x = x.view({-1, 64 * (GAME_HEIGHT - 10) * (GAME_WIDTH - 10)});
@@ -79,7 +110,12 @@ public:
         auto a = fc2->forward(x);
         auto action_probabilities = torch::softmax(a, /*dim=*/1);
 
-        if(selected_action.numel() == 0) {
+        if(selected_action.numel() == 0 && draws.defined()) {
+            //Invert the cumulative distribution at each draw, so the caller decides the randomness
+            auto cumulative = action_probabilities.cumsum(1);
+            selected_action = (cumulative < draws.to(device)).sum(1, /*keepdim=*/true).toType(torch::kLong).clamp_max(a.size(1) - 1);
+        }
+        else if(selected_action.numel() == 0) {
             //See:  https://github.com/pytorch/pytorch/blob/f79fb58744ba70970de652e46ea039b03e9ce9ff/torch/distributions/categorical.py#L110
             //      https://pytorch.org/cppdocs/api/function_namespaceat_1ac675eda9cae4819bc9311097af498b67.html?highlight=multinomial
             selected_action = action_probabilities.multinomial(1);
@@ -98,15 +134,6 @@ public:
         ModelOutput output {selected_action, log_prob, value, entropy};
         return output;
   }
-
-    torch::nn::Conv2d conv1;
-    torch::nn::Conv2d conv2;
-    torch::nn::Conv2d conv3;
-    torch::nn::Linear fc1;
-    torch::nn::Linear fc2;
-    torch::nn::Linear fc3;
-    
-    torch::Device device;
 };
 
 #endif
@@ -2,6 +2,8 @@
 #define TYPES_H
 
 #include <cstdlib>
+#include <memory>
+#include <vector>
 #include <torch/torch.h>
 
 const int NUMBER_OF_PLAYERS = 2;                //The number of players in the game
@@ -11,6 +13,8 @@ const float MAX_HALITE_ON_SHIP = 1000;          //The maximum halite a ship can
 const float MAX_SCORE_APPROXIMATE = 50000;      //A rough estimate of a "Max" score that we'll use for scaling our player's scores
 
 const int NUMBER_OF_FRAMES = 12;                //The number of NxN input frames to our neural network
+const int NUMBER_OF_SHARED_FRAMES = 10;         //The leading frames, which are the same for every ship of a player on a turn
+const int NUMBER_OF_SHIP_FRAMES = NUMBER_OF_FRAMES - NUMBER_OF_SHARED_FRAMES;   //The trailing frames, specific to one ship
 const int GAME_WIDTH = 32;                      //The number of NxN input frames to our neural network
 const int GAME_HEIGHT = 32;                     //The number of NxN input frames to our neural network
 
@@ -63,32 +67,11 @@ struct ModelOutput {
     at::Tensor entropy;
 };
 
-struct RolloutItem {
-    std::shared_ptr<EntityState> state;
-    long action;
-    float value;
-    float log_prob;
-    float reward;
-    int done;
-    long playerId;
-};
-
 struct CompleteRolloutResult {
-    std::vector<RolloutItem> rollouts;
-    std::vector<RolloutItem> spawn_rollouts;
     std::vector<long> scores;
     std::vector<long> gameSteps;
 };
 
-struct ProcessedRolloutItem {
-    std::shared_ptr<EntityState> state;
-    long action;
-    float log_prob;
-    float returns;
-    float advantage;
-};
-
-
 #endif
 
 